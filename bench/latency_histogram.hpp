@@ -0,0 +1,134 @@
+#pragma once
+
+/**
+ * @file latency_histogram.hpp
+ * @brief Гистограмма задержек с логарифмически-линейными корзинами (в духе HdrHistogram)
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace nexus::bench {
+
+/**
+ * @class LatencyHistogram
+ * @brief Гистограмма задержек в наносекундах с фиксированной относительной точностью
+ *
+ * Значения до 128 хранятся точно, дальше каждый диапазон [2^k, 2^(k+1)) делится
+ * на 64 равные корзины, поэтому относительная погрешность квантилей не превышает
+ * 1/64 (~1.6%) во всем диапазоне uint64_t. Запись - O(1) без выделения памяти.
+ *
+ * Класс тривиально копируемый: гистограммы процессов-клиентов передаются
+ * родителю через канал как есть.
+ */
+class LatencyHistogram {
+public:
+    /**
+     * @brief Учет одного значения
+     * @param value Задержка в наносекундах
+     */
+    void Record(const uint64_t value) noexcept {
+        ++counts_[IndexOf(value)];
+        ++count_;
+        sum_ += value;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    /**
+     * @brief Добавление значений другой гистограммы
+     */
+    void Merge(const LatencyHistogram& other) noexcept {
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        count_ += other.count_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    uint64_t Count() const noexcept {
+        return count_;
+    }
+
+    uint64_t Min() const noexcept {
+        return count_ > 0 ? min_ : 0;
+    }
+
+    uint64_t Max() const noexcept {
+        return max_;
+    }
+
+    double Mean() const noexcept {
+        return count_ > 0 ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0;
+    }
+
+    /**
+     * @brief Значение квантиля
+     * @param percentile Процентиль от 0 до 100
+     * @return Верхняя граница корзины, в которую попал квантиль (не больше максимума)
+     */
+    uint64_t ValueAtPercentile(const double percentile) const noexcept {
+        if (count_ == 0) {
+            return 0;
+        }
+
+        const double clamped = std::clamp(percentile, 0.0, 100.0);
+        const auto target = std::max<uint64_t>(
+            1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(count_)))
+        );
+
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            cumulative += counts_[i];
+            if (cumulative >= target) {
+                return std::min(HighestEquivalent(i), max_);
+            }
+        }
+        return max_;
+    }
+
+private:
+    static constexpr unsigned kSubBucketBits = 7;
+    static constexpr size_t kSubBucketCount = size_t{1} << kSubBucketBits;
+    static constexpr size_t kSubBucketHalf = kSubBucketCount / 2;
+
+    // Точные значения [0, 128) и по 64 корзины на каждую степень двойки выше
+    static constexpr size_t kBucketCount =
+        kSubBucketCount + (64 - kSubBucketBits) * kSubBucketHalf;
+
+    static size_t IndexOf(const uint64_t value) noexcept {
+        if (value < kSubBucketCount) {
+            return static_cast<size_t>(value);
+        }
+
+        const unsigned magnitude = 63u - static_cast<unsigned>(__builtin_clzll(value));
+        const unsigned shift = magnitude - (kSubBucketBits - 1);
+        return kSubBucketCount + (shift - 1) * kSubBucketHalf
+               + static_cast<size_t>((value >> shift) - kSubBucketHalf);
+    }
+
+    static uint64_t HighestEquivalent(const size_t index) noexcept {
+        if (index < kSubBucketCount) {
+            return index;
+        }
+
+        const size_t relative = index - kSubBucketCount;
+        const unsigned shift = static_cast<unsigned>(relative / kSubBucketHalf) + 1;
+        const uint64_t sub_bucket = relative % kSubBucketHalf + kSubBucketHalf;
+        // Для последней корзины сдвиг переполняется и дает ровно UINT64_MAX
+        return ((sub_bucket + 1) << shift) - 1;
+    }
+
+    std::array<uint64_t, kBucketCount> counts_{};
+    uint64_t count_{0};
+    uint64_t sum_{0};
+    uint64_t min_{UINT64_MAX};
+    uint64_t max_{0};
+};
+
+} // namespace nexus::bench
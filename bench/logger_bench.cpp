@@ -0,0 +1,598 @@
+/**
+ * @file logger_bench.cpp
+ * @brief Нагрузочный тест логгера: задержка вызова у клиента и сквозная пропускная способность
+ *
+ * Для каждого сочетания приемника, режима доставки, числа процессов, числа потоков
+ * и размера сообщения запускается свой экземпляр логгера. Клиентские процессы
+ * порождаются до запуска логгера и ждут общего сигнала старта, каждый поток клиента
+ * отправляет заданное число сообщений через LOG_INFO.
+ *
+ * - Задержка - время одного вызова LOG_INFO в потоке клиента, собирается в
+ *   LatencyHistogram и объединяется по всем потокам и процессам.
+ * - Пропускная способность - число сообщений, деленное на время от сигнала старта
+ *   до остановки логгера, то есть до записи и сброса последнего сообщения.
+ *
+ * Результаты выводятся в JSON (stdout или --output), ход выполнения - в stderr.
+ * Консольный приемник пишет в /dev/null: stdout процесса перенаправляется на время теста.
+ */
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// Bench
+#include "latency_histogram.hpp"
+
+// Logger
+#include "core/logger/logger_macros.hpp"
+#include "sinks/console_logger.hpp"
+#include "sinks/file_logger.hpp"
+
+// Utils & Types
+#include "common/types/channels_names.hpp"
+#include "common/utils/ipc_utils.hpp"
+#include "common/utils/time_utils.hpp"
+
+#ifndef NEXUS_LOGGER_VERSION
+#define NEXUS_LOGGER_VERSION "unknown"
+#endif
+
+namespace {
+
+using namespace nexus;
+
+enum class SinkKind {
+    CONSOLE,
+    FILE,
+    FILE_DIRECT,
+    FILE_MAPPED
+};
+
+/**
+ * @brief Параметры запуска, задаются аргументами командной строки
+ */
+struct BenchConfig {
+    /// @brief Наибольшее число потоков клиента (перебираются степени двойки до него)
+    size_t max_threads{4};
+
+    /// @brief Наибольшее число процессов-клиентов (перебираются степени двойки до него)
+    size_t max_processes{2};
+
+    /// @brief Число сообщений, отправляемых каждым потоком
+    size_t messages{10000};
+
+    /// @brief Размеры текста сообщения в байтах (по умолчанию - как в справке --sizes)
+    std::vector<size_t> sizes{16, 128, 1024, 5119};
+
+    std::vector<SinkKind> sinks{SinkKind::CONSOLE, SinkKind::FILE};
+    std::vector<logger::DeliveryMode> modes{logger::DeliveryMode::SYNC};
+
+    /// @brief Файл приемника FileLogger, удаляется перед каждым запуском
+    std::string file_path{"/tmp/nexus_logger_bench.log"};
+
+    /// @brief Файл результатов (пусто - stdout)
+    std::string output;
+};
+
+/**
+ * @brief Результат одного запуска
+ */
+struct RunResult {
+    SinkKind sink;
+    logger::DeliveryMode mode;
+    size_t processes;
+    size_t threads;
+    size_t message_size;
+    uint64_t messages;
+    uint64_t elapsed_ns;
+    bench::LatencyHistogram latency;
+};
+
+constexpr std::string_view kUsage =
+    "Usage: nexus_logger_bench [options]\n"
+    "  --threads N        max client threads per process, powers of two up to N (4)\n"
+    "  --processes N      max client processes, powers of two up to N (2)\n"
+    "  --messages N       messages per client thread (10000)\n"
+    "  --sizes A,B,...    message text sizes in bytes (16,128,1024,5119)\n"
+    "  --sinks LIST       console,file,file-direct,file-mapped (console,file)\n"
+    "  --modes LIST       sync,async,shared (sync)\n"
+    "  --file PATH        FileLogger output (/tmp/nexus_logger_bench.log)\n"
+    "  --output PATH      JSON results file (stdout)\n";
+
+std::string_view SinkName(const SinkKind sink) {
+    switch (sink) {
+        case SinkKind::CONSOLE:
+            return "console";
+        case SinkKind::FILE_DIRECT:
+            return "file-direct";
+        case SinkKind::FILE_MAPPED:
+            return "file-mapped";
+        default:
+            return "file";
+    }
+}
+
+std::string_view ModeName(const logger::DeliveryMode mode) {
+    switch (mode) {
+        case logger::DeliveryMode::ASYNC:
+            return "async";
+        case logger::DeliveryMode::SHARED_MEMORY:
+            return "shared";
+        default:
+            return "sync";
+    }
+}
+
+size_t ParseCount(const std::string_view option, const std::string& value) {
+    size_t parsed = 0;
+    try {
+        size_t end = 0;
+        parsed = std::stoul(value, &end);
+        if (end != value.size()) {
+            parsed = 0;
+        }
+    } catch (const std::exception&) {
+        parsed = 0;
+    }
+
+    if (parsed == 0) {
+        throw std::invalid_argument(std::string(option) + ": expected a positive number, got '"
+                                    + value + "'");
+    }
+    return parsed;
+}
+
+std::vector<std::string> SplitList(const std::string& value) {
+    std::vector<std::string> items;
+    size_t begin = 0;
+    while (begin <= value.size()) {
+        const size_t end = std::min(value.find(',', begin), value.size());
+        if (end > begin) {
+            items.emplace_back(value.substr(begin, end - begin));
+        }
+        begin = end + 1;
+    }
+    return items;
+}
+
+BenchConfig ParseArguments(const int argc, char** argv) {
+    BenchConfig config;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view option = argv[i];
+        if (option == "--help" || option == "-h") {
+            std::cerr << kUsage;
+            std::exit(EXIT_SUCCESS);
+        }
+
+        if (i + 1 >= argc) {
+            throw std::invalid_argument(std::string(option) + ": missing value");
+        }
+        const std::string value = argv[++i];
+
+        if (option == "--threads") {
+            config.max_threads = ParseCount(option, value);
+        } else if (option == "--processes") {
+            config.max_processes = ParseCount(option, value);
+        } else if (option == "--messages") {
+            config.messages = ParseCount(option, value);
+        } else if (option == "--sizes") {
+            config.sizes.clear();
+            for (const std::string& item : SplitList(value)) {
+                const size_t size = ParseCount(option, item);
+                if (size > ipc::kMaxPayloadSize) {
+                    throw std::invalid_argument("--sizes: " + item + " exceeds the "
+                                                + std::to_string(ipc::kMaxPayloadSize)
+                                                + " byte message limit");
+                }
+                config.sizes.push_back(size);
+            }
+        } else if (option == "--sinks") {
+            config.sinks.clear();
+            for (const std::string& item : SplitList(value)) {
+                if (item == "console") {
+                    config.sinks.push_back(SinkKind::CONSOLE);
+                } else if (item == "file") {
+                    config.sinks.push_back(SinkKind::FILE);
+                } else if (item == "file-direct") {
+                    config.sinks.push_back(SinkKind::FILE_DIRECT);
+                } else if (item == "file-mapped") {
+                    config.sinks.push_back(SinkKind::FILE_MAPPED);
+                } else {
+                    throw std::invalid_argument("--sinks: unknown sink '" + item + "'");
+                }
+            }
+        } else if (option == "--modes") {
+            config.modes.clear();
+            for (const std::string& item : SplitList(value)) {
+                if (item == "sync") {
+                    config.modes.push_back(logger::DeliveryMode::SYNC);
+                } else if (item == "async") {
+                    config.modes.push_back(logger::DeliveryMode::ASYNC);
+                } else if (item == "shared") {
+                    config.modes.push_back(logger::DeliveryMode::SHARED_MEMORY);
+                } else {
+                    throw std::invalid_argument("--modes: unknown mode '" + item + "'");
+                }
+            }
+        } else if (option == "--file") {
+            config.file_path = value;
+        } else if (option == "--output") {
+            config.output = value;
+        } else {
+            throw std::invalid_argument("unknown option " + std::string(option));
+        }
+    }
+
+    if (config.sizes.empty() || config.sinks.empty() || config.modes.empty()) {
+        throw std::invalid_argument("--sizes, --sinks and --modes must not be empty");
+    }
+    return config;
+}
+
+// Степени двойки до limit и сам limit: 1, 2, 4, ..., limit
+std::vector<size_t> SweepValues(const size_t limit) {
+    std::vector<size_t> values;
+    for (size_t value = 1; value < limit; value *= 2) {
+        values.push_back(value);
+    }
+    values.push_back(limit);
+    return values;
+}
+
+void WriteAll(const int fd, const void* data, size_t size) {
+    const auto* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        const ssize_t written = write(fd, bytes, size);
+        if (written == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::system_category(), "pipe write failed");
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+// Возвращает false, если канал закрыт раньше, чем прочитано size байт
+bool ReadAll(const int fd, void* data, size_t size) {
+    auto* bytes = static_cast<char*>(data);
+    while (size > 0) {
+        const ssize_t received = read(fd, bytes, size);
+        if (received == -1 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return false;
+        }
+        bytes += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+/**
+ * @brief Тело процесса-клиента
+ *
+ * Ждет сигнала старта, подключается к логгеру, отправляет сообщения из threads
+ * потоков и передает родителю общую гистограмму задержек. Завершается через exit(),
+ * чтобы деструктор LoggerService дослал записи, оставшиеся в буферах (ASYNC).
+ */
+[[noreturn]] void RunClientProcess(const BenchConfig& config, const logger::DeliveryMode mode,
+                                   const size_t threads, const size_t message_size,
+                                   const int start_fd, const int result_fd) {
+    try {
+        char start = 0;
+        if (!ReadAll(start_fd, &start, sizeof(start))) {
+            _exit(EXIT_FAILURE);
+        }
+
+        logger::LoggerServiceConfig service_config;
+        service_config.mode = mode;
+        logger::LoggerService::Initialize(std::make_unique<logger::LoggerService>(service_config));
+
+        const std::string payload(message_size, 'x');
+        std::vector<bench::LatencyHistogram> histograms(threads);
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&config, &payload, &histogram = histograms[t]] {
+                for (size_t i = 0; i < config.messages; ++i) {
+                    const timespec begin = utils::time::GetMonotonicTime();
+                    LOG_INFO(payload);
+                    const timespec end = utils::time::GetMonotonicTime();
+                    histogram.Record(utils::time::ToNanoseconds(end)
+                                     - utils::time::ToNanoseconds(begin));
+                }
+            });
+        }
+
+        bench::LatencyHistogram total;
+        for (size_t t = 0; t < threads; ++t) {
+            workers[t].join();
+            total.Merge(histograms[t]);
+        }
+
+        WriteAll(result_fd, &total, sizeof(total));
+    } catch (const std::exception& e) {
+        std::cerr << "Client " << getpid() << " failed: " << e.what() << '\n';
+        std::exit(EXIT_FAILURE);
+    }
+    std::exit(EXIT_SUCCESS);
+}
+
+struct ClientProcess {
+    pid_t pid{-1};
+    int start_fd{-1};
+    int result_fd{-1};
+};
+
+/**
+ * @brief Порождение клиентов, ждущих сигнала старта
+ *
+ * Вызывается, пока в процессе нет других потоков: дочерний процесс получает
+ * согласованное состояние библиотек.
+ */
+std::vector<ClientProcess> SpawnClients(const BenchConfig& config,
+                                        const logger::DeliveryMode mode,
+                                        const size_t processes, const size_t threads,
+                                        const size_t message_size) {
+    std::vector<ClientProcess> clients;
+    for (size_t p = 0; p < processes; ++p) {
+        int start_pipe[2];
+        int result_pipe[2];
+        if (pipe(start_pipe) == -1) {
+            throw std::system_error(errno, std::system_category(), "pipe failed");
+        }
+        if (pipe(result_pipe) == -1) {
+            const int error = errno;
+            close(start_pipe[0]);
+            close(start_pipe[1]);
+            throw std::system_error(error, std::system_category(), "pipe failed");
+        }
+
+        const pid_t pid = fork();
+        if (pid == -1) {
+            const int error = errno;
+            for (const int fd : {start_pipe[0], start_pipe[1], result_pipe[0], result_pipe[1]}) {
+                close(fd);
+            }
+            throw std::system_error(error, std::system_category(), "fork failed");
+        }
+
+        if (pid == 0) {
+            close(start_pipe[1]);
+            close(result_pipe[0]);
+            // Каналы ранее порожденных клиентов этому процессу не нужны
+            for (const ClientProcess& sibling : clients) {
+                close(sibling.start_fd);
+                close(sibling.result_fd);
+            }
+            RunClientProcess(config, mode, threads, message_size, start_pipe[0],
+                             result_pipe[1]);
+        }
+
+        close(start_pipe[0]);
+        close(result_pipe[1]);
+        clients.push_back({pid, start_pipe[1], result_pipe[0]});
+    }
+    return clients;
+}
+
+/**
+ * @brief Один запуск: свой логгер, clients процессов по threads потоков
+ */
+RunResult RunOnce(const BenchConfig& config, const SinkKind sink,
+                  const logger::DeliveryMode mode, const size_t processes,
+                  const size_t threads, const size_t message_size) {
+    std::remove(config.file_path.c_str());
+
+    std::vector<ClientProcess> clients =
+        SpawnClients(config, mode, processes, threads, message_size);
+
+    std::unique_ptr<logger::BaseLogger> server;
+    if (sink == SinkKind::CONSOLE) {
+        server = std::make_unique<logger::ConsoleLogger>(channels::LOGGER);
+    } else {
+        const logger::FileWriteMode file_mode =
+            sink == SinkKind::FILE_DIRECT   ? logger::FileWriteMode::DIRECT
+            : sink == SinkKind::FILE_MAPPED ? logger::FileWriteMode::MAPPED
+                                            : logger::FileWriteMode::STREAM;
+        server = std::make_unique<logger::FileLogger>(channels::LOGGER, config.file_path,
+                                                      file_mode);
+    }
+    if (mode == logger::DeliveryMode::SHARED_MEMORY) {
+        server->EnableSharedRing();
+    }
+
+    std::exception_ptr server_error;
+    std::thread server_thread([&server, &server_error] {
+        try {
+            server->Run();
+        } catch (...) {
+            server_error = std::current_exception();
+        }
+    });
+
+    // Синхронное сообщение возвращается только после ответа цикла приема,
+    // то есть когда логгер запущен и опубликовал порог уровня
+    const int coid = utils::ipc::ConnectToProcess(channels::LOGGER);
+    utils::ipc::SendMessage(coid, ipc::LOG_INFO,
+                            "bench: sink=" + std::string(SinkName(sink))
+                            + " mode=" + std::string(ModeName(mode))
+                            + " processes=" + std::to_string(processes)
+                            + " threads=" + std::to_string(threads)
+                            + " size=" + std::to_string(message_size));
+
+    const timespec start = utils::time::GetMonotonicTime();
+
+    const char go = 1;
+    for (ClientProcess& client : clients) {
+        WriteAll(client.start_fd, &go, sizeof(go));
+        close(client.start_fd);
+    }
+
+    RunResult result{sink, mode, processes, threads, message_size,
+                     static_cast<uint64_t>(processes * threads * config.messages), 0, {}};
+
+    bool clients_failed = false;
+    for (const ClientProcess& client : clients) {
+        bench::LatencyHistogram latency;
+        if (ReadAll(client.result_fd, &latency, sizeof(latency))) {
+            result.latency.Merge(latency);
+        } else {
+            clients_failed = true;
+        }
+        close(client.result_fd);
+
+        int status = 0;
+        while (waitpid(client.pid, &status, 0) == -1 && errno == EINTR) {
+        }
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+            clients_failed = true;
+        }
+    }
+
+    // Логгер дописывает и сбрасывает все принятое перед выходом из Run()
+    utils::ipc::SendPulse(coid, ipc::CurrentPriority(), ipc::PULSE_SHUTDOWN);
+    utils::ipc::Disconnect(coid);
+    server_thread.join();
+
+    const timespec end = utils::time::GetMonotonicTime();
+    result.elapsed_ns = utils::time::ToNanoseconds(end) - utils::time::ToNanoseconds(start);
+
+    if (server_error) {
+        std::rethrow_exception(server_error);
+    }
+    if (clients_failed) {
+        throw std::runtime_error("benchmark client process failed");
+    }
+    return result;
+}
+
+void WriteJson(std::FILE* out, const BenchConfig& config, const std::vector<RunResult>& results) {
+    char date[utils::time::kTimeStringSize];
+    const time_t now = ::time(nullptr);
+    tm utc{};
+    gmtime_r(&now, &utc);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", &utc);
+
+    std::fprintf(out, "{\n");
+    std::fprintf(out, "  \"benchmark\": \"nexus_logger_bench\",\n");
+    std::fprintf(out, "  \"version\": \"%s\",\n", NEXUS_LOGGER_VERSION);
+    std::fprintf(out, "  \"date\": \"%s\",\n", date);
+    std::fprintf(out, "  \"messages_per_thread\": %zu,\n", config.messages);
+    std::fprintf(out, "  \"results\": [");
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const RunResult& r = results[i];
+        const double seconds = static_cast<double>(r.elapsed_ns) / 1e9;
+        const double rate = seconds > 0 ? static_cast<double>(r.messages) / seconds : 0.0;
+        const double bytes_rate = rate * static_cast<double>(r.message_size) / (1024.0 * 1024.0);
+
+        std::fprintf(out, "%s\n    {\n", i == 0 ? "" : ",");
+        std::fprintf(out, "      \"sink\": \"%s\",\n", SinkName(r.sink).data());
+        std::fprintf(out, "      \"mode\": \"%s\",\n", ModeName(r.mode).data());
+        std::fprintf(out, "      \"processes\": %zu,\n", r.processes);
+        std::fprintf(out, "      \"threads\": %zu,\n", r.threads);
+        std::fprintf(out, "      \"message_size\": %zu,\n", r.message_size);
+        std::fprintf(out, "      \"messages\": %llu,\n",
+                     static_cast<unsigned long long>(r.messages));
+        std::fprintf(out, "      \"elapsed_s\": %.6f,\n", seconds);
+        std::fprintf(out, "      \"throughput_msg_s\": %.1f,\n", rate);
+        std::fprintf(out, "      \"throughput_mib_s\": %.3f,\n", bytes_rate);
+        std::fprintf(out, "      \"latency_ns\": {\"min\": %llu, \"mean\": %.1f, \"p50\": %llu, "
+                          "\"p99\": %llu, \"p99_9\": %llu, \"max\": %llu}\n",
+                     static_cast<unsigned long long>(r.latency.Min()), r.latency.Mean(),
+                     static_cast<unsigned long long>(r.latency.ValueAtPercentile(50.0)),
+                     static_cast<unsigned long long>(r.latency.ValueAtPercentile(99.0)),
+                     static_cast<unsigned long long>(r.latency.ValueAtPercentile(99.9)),
+                     static_cast<unsigned long long>(r.latency.Max()));
+        std::fprintf(out, "    }");
+    }
+
+    std::fprintf(out, "\n  ]\n}\n");
+}
+
+} // namespace
+
+int main(const int argc, char** argv) {
+    try {
+        const BenchConfig config = ParseArguments(argc, argv);
+
+        // Клиент, завершившийся раньше сигнала старта, не должен ронять тест
+        signal(SIGPIPE, SIG_IGN);
+
+        std::FILE* out = nullptr;
+        if (config.output.empty()) {
+            const int stdout_copy = dup(STDOUT_FILENO);
+            out = stdout_copy == -1 ? nullptr : fdopen(stdout_copy, "w");
+        } else {
+            out = std::fopen(config.output.c_str(), "w");
+        }
+        if (out == nullptr) {
+            throw std::system_error(errno, std::system_category(), "cannot open results output");
+        }
+
+        // ConsoleLogger пишет в /dev/null, результаты идут в сохраненный stdout
+        std::fflush(stdout);
+        const int null_fd = open("/dev/null", O_WRONLY);
+        if (null_fd == -1 || dup2(null_fd, STDOUT_FILENO) == -1) {
+            throw std::system_error(errno, std::system_category(), "cannot redirect stdout");
+        }
+        close(null_fd);
+
+        std::vector<RunResult> results;
+        for (const SinkKind sink : config.sinks) {
+            for (const logger::DeliveryMode mode : config.modes) {
+                for (const size_t processes : SweepValues(config.max_processes)) {
+                    for (const size_t threads : SweepValues(config.max_threads)) {
+                        for (const size_t size : config.sizes) {
+                            const RunResult& r = results.emplace_back(
+                                RunOnce(config, sink, mode, processes, threads, size));
+
+                            const double seconds = static_cast<double>(r.elapsed_ns) / 1e9;
+                            std::cerr << SinkName(sink) << ' ' << ModeName(mode)
+                                      << " processes=" << processes << " threads=" << threads
+                                      << " size=" << size << ": "
+                                      << static_cast<uint64_t>(
+                                             static_cast<double>(r.messages) / seconds)
+                                      << " msg/s, p50=" << r.latency.ValueAtPercentile(50.0)
+                                      << "ns p99=" << r.latency.ValueAtPercentile(99.0)
+                                      << "ns p99.9=" << r.latency.ValueAtPercentile(99.9)
+                                      << "ns max=" << r.latency.Max() << "ns\n";
+                        }
+                    }
+                }
+            }
+        }
+
+        std::remove(config.file_path.c_str());
+
+        WriteJson(out, config, results);
+        std::fclose(out);
+        return EXIT_SUCCESS;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}
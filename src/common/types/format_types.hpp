@@ -0,0 +1,68 @@
+#pragma once
+
+/**
+ * @file format_types.hpp
+ * @brief Бинарное представление записей с отложенным форматированием
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Types
+#include "message_types.hpp"
+
+namespace nexus::ipc {
+
+/**
+ * @brief Тип аргумента в бинарной записи LOG_FORMATTED
+ *
+ * За тегом следует значение: числа - в порядке байт отправителя,
+ * STRING - длина uint16_t и байты строки без завершающего нуля.
+ */
+enum class ArgType : uint8_t {
+    INT32 = 1,
+    UINT32 = 2,
+    INT64 = 3,
+    UINT64 = 4,
+    DOUBLE = 5,
+    BOOL = 6,
+    CHAR = 7,
+    STRING = 8,
+    POINTER = 9
+};
+
+// Максимальный размер заголовка и аргументов одной записи LOG_FORMATTED
+constexpr size_t kMaxFormattedPayload = 1024;
+
+#pragma pack(push, 1)
+// Заголовок регистрации LOG_FORMAT, за ним следует текст формата
+// Имя клиента логгер знает из LOG_REGISTER
+struct FormatRegistration {
+    uint32_t client_id;
+    uint32_t format_id;
+};
+
+// Заголовок записи LOG_FORMATTED, за ним следуют arg_count аргументов
+struct FormattedHeader {
+    MessageCode level;
+    uint32_t client_id;
+    uint32_t format_id;
+    uint8_t arg_count;
+};
+#pragma pack(pop)
+
+// Код уровня записи с учетом LOG_FORMATTED, у которой уровень лежит в заголовке записи
+inline MessageCode LevelOfRecord(const MessageCode code, const std::string_view payload) {
+    if (code == LOG_FORMATTED && !payload.empty()) {
+        return static_cast<MessageCode>(payload.front());
+    }
+    return code;
+}
+
+// Уровень записи с учетом LOG_FORMATTED
+inline Severity SeverityOfRecord(const MessageCode code, const std::string_view payload) {
+    return SeverityOf(LevelOfRecord(code, payload));
+}
+
+} // namespace nexus::ipc
@@ -1,24 +1,107 @@
 #pragma once
 
-//QNX
-#include <sys/neutrino.h>
+#include <cstddef>
+#include <cstdint>
+
+// Types
+#include "pulse_types.hpp"
 
 namespace nexus::ipc {
 
 enum MessageCode : uint8_t {
     LOG_INFO = 0x30,
-    LOG_ERROR = 0x31
+    LOG_ERROR = 0x31,
+    LOG_TRACE = 0x32,
+    LOG_DEBUG = 0x33,
+    LOG_WARN = 0x34,
+    LOG_FATAL = 0x35,
+    LOG_BATCH = 0x40,
+    LOG_FORMAT = 0x41,   ///< Регистрация строки формата: FormatRegistration и текст формата
+    LOG_FORMATTED = 0x42, ///< Запись с отложенным форматированием: FormattedHeader и аргументы
+    LOG_REGISTER = 0x43,  ///< Регистрация клиента: имя, под которым логгер пишет его записи
+    STATS_QUERY = 0x50    ///< Запрос метрик: ответ содержит LoggerStatsSnapshot (stats_types.hpp)
+};
+
+// Порядок уровней логирования для сравнения с порогом
+// Значения совпадают с NEXUS_LOG_LEVEL_* в logger_macros.hpp
+enum Severity : uint8_t {
+    SEVERITY_TRACE = 0,
+    SEVERITY_DEBUG = 1,
+    SEVERITY_INFO = 2,
+    SEVERITY_WARN = 3,
+    SEVERITY_ERROR = 4,
+    SEVERITY_FATAL = 5,
+    SEVERITY_OFF = 6 ///< Только для порога: отключает все уровни
+};
+
+// Уровень сообщения по его коду (коды сохранены для совместимости и не упорядочены)
+constexpr Severity SeverityOf(const MessageCode code) {
+    switch (code) {
+        case LOG_TRACE:
+            return SEVERITY_TRACE;
+        case LOG_DEBUG:
+            return SEVERITY_DEBUG;
+        case LOG_WARN:
+            return SEVERITY_WARN;
+        case LOG_ERROR:
+            return SEVERITY_ERROR;
+        case LOG_FATAL:
+            return SEVERITY_FATAL;
+        default:
+            return SEVERITY_INFO;
+    }
+}
+
+// Версия протокола: меняется при любом несовместимом изменении MessageHeader,
+// BatchHeader или RecordHeader
+constexpr uint8_t kProtocolVersion = 4;
+
+// Наибольшая длина данных одного сообщения; более длинные данные клиент обрезает
+constexpr size_t kMaxPayloadSize = 1024 * 1024;
+
+// Флаги сообщения (MessageHeader::flags)
+enum MessageFlags : uint16_t {
+    MESSAGE_TRUNCATED = 0x0001 ///< Клиент обрезал данные до kMaxPayloadSize
 };
 
 #pragma pack(push, 1)
+// Заголовок каждого сообщения клиента, за ним следуют length байт данных
+struct MessageHeader {
+    MessageCode code;
+    uint8_t version;       ///< kProtocolVersion отправителя
+    uint16_t flags;        ///< MessageFlags
+    uint32_t length;       ///< Длина данных после заголовка
+    uint32_t sequence;     ///< Порядковый номер сообщения в процессе отправителя
+    uint64_t timestamp;    ///< Метка CaptureTicks() при создании (0 - не задана, время приема)
+};
+
+// Размер буфера приема: заголовок и начало данных. Остаток длинных сообщений
+// сервер дочитывает отдельно (Channel::Read), короткие принимаются целиком
+constexpr size_t kReceiveBufferSize = 1024;
+
+// Сообщение в буфере приема
 struct IpcMessage {
+    MessageHeader header;
+    char text[kReceiveBufferSize - sizeof(MessageHeader)];
+};
+
+// Заголовок пакета записей LOG_BATCH, размещается в начале данных сообщения
+struct BatchHeader {
+    uint16_t record_count;
+};
+
+// Заголовок отдельной записи в пакете, за ним следует length байт текста
+struct RecordHeader {
     MessageCode code;
-    char text[5119];
+    uint32_t thread_id;    ///< Поток-автор записи (ipc::CurrentThreadId())
+    uint32_t sequence;
+    uint64_t timestamp;    ///< Метка CaptureTicks() при вызове LOG_* (0 - время приема)
+    uint16_t length;
 };
 #pragma pack(pop)
 
 union IpcBuffer {
-    _pulse ipc_pulse;
+    Pulse ipc_pulse;
     IpcMessage ipc_message;
 };
 
@@ -1,13 +1,29 @@
 #pragma once
 
-#include <sys/neutrino.h>
+#include <cstdint>
 
 namespace nexus::ipc {
 
+// Наибольший код пульса, доступный приложению (_PULSE_CODE_MAXAVAIL в QNX)
+constexpr int kPulseCodeMaxAvail = 127;
+
 #pragma pack(push, 1)
 enum PulseCode : uint8_t {
-    PULSE_SHUTDOWN = _PULSE_CODE_MAXAVAIL
+    PULSE_SHUTDOWN = kPulseCodeMaxAvail,
+    PULSE_RING_DOORBELL = kPulseCodeMaxAvail - 1,
+    PULSE_FLUSH_TIMER = kPulseCodeMaxAvail - 2,
+    PULSE_WAKEUP = kPulseCodeMaxAvail - 3,
+    PULSE_SET_LEVEL = kPulseCodeMaxAvail - 4, ///< Новый порог уровня в value (ipc::Severity)
+    PULSE_STATS_TIMER = kPulseCodeMaxAvail - 5,
+    PULSE_DROP_REPORT = kPulseCodeMaxAvail - 6, ///< Вывод числа отброшенных записей
+    PULSE_REPEAT_TIMER = kPulseCodeMaxAvail - 7 ///< Вывод сводок подавленных повторов
+};
+
+// Пульс, принятый каналом: короткое уведомление без ответа
+struct Pulse {
+    int8_t code;
+    int32_t value;
 };
 #pragma pack(pop)
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+/**
+ * @file stats_types.hpp
+ * @brief Снимок внутренних метрик логгера, возвращаемый в ответ на STATS_QUERY
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nexus::ipc {
+
+// Версия формата LoggerStatsSnapshot, меняется при любом изменении полей
+constexpr uint32_t kStatsVersion = 2;
+
+// Число корзин гистограммы задержек: корзина i - [2^i, 2^(i+1)) нс, последняя открыта сверху
+constexpr size_t kLatencyBucketCount = 32;
+
+#pragma pack(push, 1)
+// Гистограмма задержек со степенями двойки: точность в пределах 2 раз, 256 байт
+struct LatencyBuckets {
+    uint64_t counts[kLatencyBucketCount];
+};
+
+// Снимок метрик логгера с момента запуска Run()
+struct LoggerStatsSnapshot {
+    uint32_t version;
+    uint64_t uptime_ns;
+
+    // Прием: записи из канала, пакетов LOG_BATCH и разделяемого буфера
+    uint64_t messages_received;
+    uint64_t bytes_received;
+    uint64_t batches_received;
+    uint64_t pulses_received;
+    uint64_t receive_errors;
+
+    // Запись: строки, переданные приемнику, и вызовы Flush()
+    uint64_t records_written;
+    uint64_t bytes_written;
+    uint64_t flushes;
+
+    // Очередь между приемом и записью
+    uint32_t queue_depth;
+    uint32_t queue_depth_max;
+    uint32_t queue_capacity;
+
+    // Записи, отброшенные политикой переполнения очереди
+    uint64_t messages_dropped;
+
+    // Время от приема сообщения до готовности ответа: столько клиент ждет логгер
+    LatencyBuckets reply_latency;
+    LatencyBuckets write_latency;
+    LatencyBuckets flush_latency;
+};
+#pragma pack(pop)
+
+// Корзина для значения в наносекундах
+constexpr size_t LatencyBucketOf(const uint64_t nanoseconds) {
+    size_t bucket = 0;
+    for (uint64_t value = nanoseconds >> 1; value != 0 && bucket + 1 < kLatencyBucketCount;
+         value >>= 1) {
+        ++bucket;
+    }
+    return bucket;
+}
+
+// Верхняя граница корзины в наносекундах (не включительно)
+constexpr uint64_t LatencyBucketLimit(const size_t bucket) {
+    return uint64_t{1} << (bucket + 1);
+}
+
+// Число значений в гистограмме
+inline uint64_t LatencyCount(const LatencyBuckets& buckets) {
+    uint64_t count = 0;
+    for (const uint64_t bucket_count : buckets.counts) {
+        count += bucket_count;
+    }
+    return count;
+}
+
+// Оценка квантиля сверху: граница корзины, в которую попал процентиль (0 - нет данных)
+inline uint64_t LatencyPercentile(const LatencyBuckets& buckets, const double percentile) {
+    const uint64_t count = LatencyCount(buckets);
+    if (count == 0) {
+        return 0;
+    }
+
+    const double target = percentile / 100.0 * static_cast<double>(count);
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < kLatencyBucketCount; ++i) {
+        cumulative += buckets.counts[i];
+        if (static_cast<double>(cumulative) >= target && cumulative > 0) {
+            return LatencyBucketLimit(i);
+        }
+    }
+    return LatencyBucketLimit(kLatencyBucketCount - 1);
+}
+
+} // namespace nexus::ipc
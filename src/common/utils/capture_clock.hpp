@@ -0,0 +1,269 @@
+#pragma once
+
+/**
+ * @file capture_clock.hpp
+ * @brief Дешевые метки времени клиента и их перевод в часы логгера
+ */
+
+#include <time.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#if defined(__QNX__)
+#include <sys/neutrino.h>
+#include <sys/syspage.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+// Utils
+#include "time_utils.hpp"
+
+namespace nexus::utils::time {
+
+/**
+ * @brief Источник меток CaptureTicks()
+ *
+ * Определяется платформой и процессором, поэтому одинаков у клиентов
+ * и логгера на одном узле и по сети не передается.
+ */
+enum class CaptureSource : uint8_t {
+    CYCLES,   ///< Счетчик тактов: ClockCycles() в QNX, инвариантный TSC на x86
+    MONOTONIC ///< Наносекунды CLOCK_MONOTONIC (грубых часов, если их точности хватает)
+};
+
+namespace detail {
+inline bool HasInvariantTsc() noexcept {
+#if !defined(__QNX__) && (defined(__x86_64__) || defined(__i386__))
+    unsigned eax = 0;
+    unsigned ebx = 0;
+    unsigned ecx = 0;
+    unsigned edx = 0;
+    return __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) != 0 && (edx & (1u << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+// Грубые часы допустимы, если их шаг не хуже миллисекунды - точности меток по умолчанию
+inline clockid_t MonotonicCaptureClock() noexcept {
+#ifdef CLOCK_MONOTONIC_COARSE
+    timespec resolution{};
+    if (clock_getres(CLOCK_MONOTONIC_COARSE, &resolution) == 0 && resolution.tv_sec == 0
+        && resolution.tv_nsec <= 1000000) {
+        return CLOCK_MONOTONIC_COARSE;
+    }
+#endif
+    return CLOCK_MONOTONIC;
+}
+} // namespace detail
+
+inline CaptureSource GetCaptureSource() noexcept {
+#if defined(__QNX__)
+    return CaptureSource::CYCLES;
+#else
+    static const CaptureSource source =
+        detail::HasInvariantTsc() ? CaptureSource::CYCLES : CaptureSource::MONOTONIC;
+    return source;
+#endif
+}
+
+/**
+ * @brief Метка времени в момент вызова LOG_*
+ *
+ * Одна инструкция чтения счетчика тактов или чтение часов через vDSO, без
+ * системного вызова. В стену время переводит логгер (CaptureCalibration).
+ * Ноль не возвращается: он означает "метка не задана".
+ */
+inline uint64_t CaptureTicks() noexcept {
+#if defined(__QNX__)
+    return ClockCycles();
+#else
+#if defined(__x86_64__) || defined(__i386__)
+    if (GetCaptureSource() == CaptureSource::CYCLES) {
+        return __rdtsc();
+    }
+#endif
+    static const clockid_t clock = detail::MonotonicCaptureClock();
+    timespec ts{};
+    clock_gettime(clock, &ts);
+    return ToNanoseconds(ts);
+#endif
+}
+
+/**
+ * @class CaptureCalibration
+ * @brief Перевод меток CaptureTicks() в CLOCK_REALTIME и CLOCK_MONOTONIC
+ *
+ * Хранит опорную точку (метка, системное и монотонное время) и длительность
+ * такта. Перевод - одно умножение и сложение без обращения к часам. Опорная
+ * точка обновляется не чаще раза в секунду первым потоком, увидевшим более
+ * свежую метку, что учитывает коррекцию системного времени; длительность
+ * такта при этом уточняется по все более длинному интервалу с момента создания.
+ *
+ * @note Потокобезопасен: чтение опорной точки - seqlock без блокировок
+ */
+class CaptureCalibration {
+public:
+    CaptureCalibration() noexcept {
+        Sample(start_ticks_, start_monotonic_);
+
+        double ns_per_tick = 1.0;
+        if (GetCaptureSource() == CaptureSource::CYCLES) {
+#if defined(__QNX__)
+            ns_per_tick = 1e9 / static_cast<double>(SYSPAGE_ENTRY(qtime)->cycles_per_sec);
+#else
+            // Первая оценка частоты, дальше уточняется при обновлении опорной точки
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            uint64_t ticks = 0;
+            uint64_t monotonic = 0;
+            Sample(ticks, monotonic);
+            ns_per_tick = MeasureNsPerTick(ticks, monotonic, 1.0);
+#endif
+        }
+        ns_per_tick_.store(ns_per_tick, std::memory_order_relaxed);
+        Refresh();
+    }
+
+    CaptureCalibration(const CaptureCalibration&) = delete;
+    CaptureCalibration& operator=(const CaptureCalibration&) = delete;
+
+    /// @brief Наносекунды CLOCK_REALTIME для метки клиента
+    uint64_t ToRealTime(const uint64_t ticks) const noexcept {
+        const Anchor anchor = Load(ticks);
+        return Shift(anchor.real_ns, ticks, anchor);
+    }
+
+    /// @brief Наносекунды CLOCK_MONOTONIC для метки клиента
+    uint64_t ToMonotonic(const uint64_t ticks) const noexcept {
+        const Anchor anchor = Load(ticks);
+        return Shift(anchor.monotonic_ns, ticks, anchor);
+    }
+
+private:
+    struct Anchor {
+        uint64_t ticks;
+        uint64_t real_ns;
+        uint64_t monotonic_ns;
+        double ns_per_tick;
+    };
+
+    // Период обновления опорной точки
+    static constexpr uint64_t kRefreshPeriodNs = 1000000000;
+
+    static uint64_t Shift(const uint64_t base, const uint64_t ticks,
+                          const Anchor& anchor) noexcept {
+        // Метка может быть старше опорной точки: записи, накопленные без соединения
+        const auto delta = static_cast<int64_t>(
+            static_cast<double>(static_cast<int64_t>(ticks - anchor.ticks)) * anchor.ns_per_tick);
+        return delta < 0 && static_cast<uint64_t>(-delta) > base
+                   ? 0
+                   : base + static_cast<uint64_t>(delta);
+    }
+
+    // Парное чтение метки и монотонных часов: из нескольких попыток берется
+    // самая узкая, чтобы вытеснение потока между чтениями не исказило частоту
+    static void Sample(uint64_t& ticks, uint64_t& monotonic) noexcept {
+        uint64_t best_window = UINT64_MAX;
+        for (int i = 0; i < 5; ++i) {
+            const uint64_t before = ToNanoseconds(GetMonotonicTime());
+            const uint64_t sample = CaptureTicks();
+            const uint64_t after = ToNanoseconds(GetMonotonicTime());
+            if (after - before < best_window) {
+                best_window = after - before;
+                ticks = sample;
+                monotonic = before + (after - before) / 2;
+            }
+        }
+    }
+
+    double MeasureNsPerTick(const uint64_t ticks, const uint64_t monotonic,
+                            const double fallback) const noexcept {
+        return ticks > start_ticks_ && monotonic > start_monotonic_
+                   ? static_cast<double>(monotonic - start_monotonic_)
+                         / static_cast<double>(ticks - start_ticks_)
+                   : fallback;
+    }
+
+    Anchor Load(const uint64_t ticks) const noexcept {
+        bool refreshed = false;
+        for (;;) {
+            const uint32_t version = version_.load(std::memory_order_acquire);
+            if ((version & 1) != 0) {
+                continue;
+            }
+
+            Anchor anchor{anchor_ticks_.load(std::memory_order_relaxed),
+                          anchor_real_.load(std::memory_order_relaxed),
+                          anchor_monotonic_.load(std::memory_order_relaxed),
+                          ns_per_tick_.load(std::memory_order_relaxed)};
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (version_.load(std::memory_order_relaxed) != version) {
+                continue;
+            }
+
+            // Одна попытка обновления: метка из будущего (рассинхронизация
+            // счетчиков ядер) не должна зациклить перевод
+            const auto age = static_cast<int64_t>(ticks - anchor.ticks);
+            if (!refreshed && age > 0
+                && static_cast<double>(age) * anchor.ns_per_tick > kRefreshPeriodNs) {
+                refreshed = true;
+                if (Refresh()) {
+                    continue;
+                }
+            }
+            return anchor;
+        }
+    }
+
+    // Новая опорная точка; false, если ее уже обновляет другой поток
+    bool Refresh() const noexcept {
+        std::unique_lock<std::mutex> lock(refresh_mutex_, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            return false;
+        }
+
+        uint64_t ticks = 0;
+        uint64_t monotonic = 0;
+        Sample(ticks, monotonic);
+        const uint64_t real = ToNanoseconds(GetCurrentTime())
+                              - (ToNanoseconds(GetMonotonicTime()) - monotonic);
+
+        double ns_per_tick = 1.0;
+        if (GetCaptureSource() == CaptureSource::CYCLES) {
+#if defined(__QNX__)
+            ns_per_tick = ns_per_tick_.load(std::memory_order_relaxed);
+#else
+            ns_per_tick = MeasureNsPerTick(ticks, monotonic,
+                                           ns_per_tick_.load(std::memory_order_relaxed));
+#endif
+        }
+
+        const uint32_t version = version_.load(std::memory_order_relaxed);
+        version_.store(version + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        anchor_ticks_.store(ticks, std::memory_order_relaxed);
+        anchor_real_.store(real, std::memory_order_relaxed);
+        anchor_monotonic_.store(monotonic, std::memory_order_relaxed);
+        ns_per_tick_.store(ns_per_tick, std::memory_order_relaxed);
+        version_.store(version + 2, std::memory_order_release);
+        return true;
+    }
+
+    uint64_t start_ticks_{0};
+    uint64_t start_monotonic_{0};
+
+    mutable std::mutex refresh_mutex_;
+    mutable std::atomic<uint32_t> version_{0};
+    mutable std::atomic<uint64_t> anchor_ticks_{0};
+    mutable std::atomic<uint64_t> anchor_real_{0};
+    mutable std::atomic<uint64_t> anchor_monotonic_{0};
+    mutable std::atomic<double> ns_per_tick_{1.0};
+};
+
+} // namespace nexus::utils::time
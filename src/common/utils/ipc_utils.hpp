@@ -1,9 +1,13 @@
 #pragma once
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <initializer_list>
+#include <string>
 #include <system_error>
 
-// QNX
-#include <sys/dispatch.h>
+// Transport
+#include "../../core/ipc/transport.hpp"
 
 // Common
 #include "../types/message_types.hpp"
@@ -12,26 +16,73 @@ namespace nexus::utils::ipc {
 
 using namespace nexus::ipc;
 
-// Безопасная отправка строкового сообщения
-static bool SendMessage(const int connection_id, const MessageCode code,
-                        const std::string& message) {
+// Максимальное число фрагментов текста в одном сообщении
+constexpr size_t kMaxMessageParts = 8;
+
+// Порядковый номер следующего сообщения процесса (MessageHeader::sequence)
+inline std::atomic<uint32_t> next_message_sequence{0};
+
+// Заголовок сообщения текущей версии протокола
+inline MessageHeader MakeHeader(const MessageCode code, const uint64_t timestamp = 0) {
+    return {code, kProtocolVersion, 0, 0,
+            next_message_sequence.fetch_add(1, std::memory_order_relaxed), timestamp};
+}
+
+// Отправка сообщения из нескольких фрагментов (scatter-gather) без копирования
+// Заголовок и фрагменты передаются транспорту отдельными частями, данные длиннее
+// kMaxPayloadSize обрезаются с флагом MESSAGE_TRUNCATED
+// timestamp - метка CaptureTicks() создания сообщения (0 - логгер возьмет время приема)
+static bool SendMessageV(const int connection_id, const MessageCode code,
+                         const std::initializer_list<MessagePart> parts,
+                         const uint64_t timestamp = 0) {
     if (connection_id == -1) {
         return false;
     }
 
-    IpcMessage msg{};
-    msg.code = code;
+    MessageHeader header = MakeHeader(code, timestamp);
+    MessagePart message[kMaxMessageParts + 1];
+    message[0] = {&header, sizeof(header)};
+
+    size_t part_count = 1;
+    for (const MessagePart& part : parts) {
+        if (part_count > kMaxMessageParts) {
+            header.flags |= MESSAGE_TRUNCATED;
+            break;
+        }
+
+        const size_t part_size = std::min<size_t>(part.size, kMaxPayloadSize - header.length);
+        if (part_size < part.size) {
+            header.flags |= MESSAGE_TRUNCATED;
+        }
+        if (part_size == 0) {
+            continue;
+        }
+
+        message[part_count] = {part.data, part_size};
+        header.length += static_cast<uint32_t>(part_size);
+        ++part_count;
+    }
+
+    return SendV(connection_id, message, part_count) != -1;
+}
+
+// Безопасная отправка строкового сообщения
+static bool SendMessage(const int connection_id, const MessageCode code,
+                        const std::string& message) {
+    return SendMessageV(connection_id, code, {{message.data(), message.size()}});
+}
 
-    // Копируем только нужную часть
-    const size_t message_size
-        = std::min(message.size(), sizeof(msg.text) - 1);
-    std::memcpy(msg.text, message.c_str(), message_size);
-    msg.text[message_size] = '\0';
+// Отправка запроса из одного заголовка с ожиданием данных ответа
+// Возвращает статус ответа сервера или -1
+static int SendRequest(const int connection_id, const MessageCode code, void* reply,
+                       const size_t reply_size) {
+    if (connection_id == -1) {
+        return -1;
+    }
 
-    // Отправляем только заголовок + актуальные данные + 1 для null-terminator
-    const size_t total_size = sizeof(MessageCode) + message_size + 1;
-    return MsgSend(connection_id, &msg, total_size,
-                   nullptr, 0) != -1;
+    const MessageHeader header = MakeHeader(code);
+    const MessagePart part{&header, sizeof(header)};
+    return SendV(connection_id, &part, 1, reply, reply_size);
 }
 
 // Отправка пульса
@@ -41,12 +92,12 @@ static bool SendPulse(const int connection_id, const int priority,
         return false;
     }
 
-    return MsgSendPulse(connection_id, priority, code, value) != -1;
+    return nexus::ipc::SendPulse(connection_id, priority, code, value);
 }
 
 // Подключение к процессу с обработкой ошибок
 static int ConnectToProcess(const std::string& channel_name) {
-    const int coid = name_open(channel_name.c_str(), 0);
+    const int coid = Connect(channel_name);
     if (coid == -1) {
         throw std::system_error(errno, std::system_category(),
                                 "cannot connect to: " + channel_name);
@@ -57,7 +108,7 @@ static int ConnectToProcess(const std::string& channel_name) {
 // Безопасное отключение
 static void Disconnect(const int connection_id) {
     if (connection_id != -1) {
-        ConnectDetach(connection_id);
+        nexus::ipc::Disconnect(connection_id);
     }
 }
 
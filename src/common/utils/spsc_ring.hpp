@@ -0,0 +1,177 @@
+#pragma once
+
+/**
+ * @file spsc_ring.hpp
+ * @brief Lock-free кольцевой буфер записей переменной длины (один писатель, один читатель)
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace nexus::utils {
+
+/**
+ * @class SpscRing
+ * @brief Кольцевой буфер байтовых записей для пары "поток-производитель / поток-потребитель"
+ *
+ * Каждая запись хранится непрерывно: 8-байтовый префикс длины и данные, выровненные на 8.
+ * Если запись не помещается до конца буфера, производитель ставит маркер переноса
+ * и пишет запись с начала. Запись и чтение выполняются в два шага (Begin/End),
+ * что позволяет формировать данные прямо в буфере без промежуточных копий.
+ *
+ * @note Потокобезопасность: методы записи вызываются только одним потоком,
+ *       методы чтения - только одним (другим) потоком.
+ */
+class SpscRing {
+public:
+    /**
+     * @brief Конструктор
+     * @param capacity Желаемый размер буфера в байтах (округляется вверх до степени двойки)
+     */
+    explicit SpscRing(size_t capacity)
+        : capacity_(RoundUpToPowerOfTwo(capacity < kMinCapacity ? kMinCapacity : capacity)),
+          mask_(capacity_ - 1), buffer_(new char[capacity_]) {
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /**
+     * @brief Максимальный размер данных одной записи
+     *
+     * Ограничение в половину буфера гарантирует, что запись всегда поместится
+     * в опустевший буфер независимо от текущей позиции.
+     */
+    size_t MaxRecordSize() const noexcept {
+        return capacity_ / 2 - kPrefixSize;
+    }
+
+    /**
+     * @brief Резервирование места под запись (сторона производителя)
+     * @param size Размер данных записи
+     * @return Указатель на область для данных или nullptr, если места нет
+     */
+    void* BeginWrite(const size_t size) noexcept {
+        if (size > MaxRecordSize()) {
+            return nullptr;
+        }
+
+        const size_t need = Align(kPrefixSize + size);
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t offset = head & mask_;
+        const size_t contiguous = capacity_ - offset;
+        const size_t total = need <= contiguous ? need : contiguous + need;
+
+        if (total > capacity_ - (head - cached_tail_)) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (total > capacity_ - (head - cached_tail_)) {
+                return nullptr;
+            }
+        }
+
+        if (need > contiguous) {
+            StorePrefix(offset, kWrapMarker);
+            head += contiguous;
+            offset = 0;
+        }
+
+        StorePrefix(offset, static_cast<uint64_t>(size));
+        pending_head_ = head + need;
+        return buffer_.get() + offset + kPrefixSize;
+    }
+
+    /**
+     * @brief Публикация зарезервированной записи для потребителя
+     */
+    void EndWrite() noexcept {
+        head_.store(pending_head_, std::memory_order_release);
+    }
+
+    /**
+     * @brief Получение самой старой записи (сторона потребителя)
+     * @param size [out] Размер данных записи
+     * @return Указатель на данные записи или nullptr, если буфер пуст
+     */
+    const void* BeginRead(size_t& size) noexcept {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == cached_head_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail == cached_head_) {
+                return nullptr;
+            }
+        }
+
+        size_t offset = tail & mask_;
+        uint64_t prefix = LoadPrefix(offset);
+        if (prefix == kWrapMarker) {
+            tail += capacity_ - offset;
+            offset = 0;
+            prefix = LoadPrefix(offset);
+        }
+
+        size = static_cast<size_t>(prefix);
+        pending_tail_ = tail + Align(kPrefixSize + size);
+        return buffer_.get() + offset + kPrefixSize;
+    }
+
+    /**
+     * @brief Освобождение прочитанной записи
+     */
+    void EndRead() noexcept {
+        tail_.store(pending_tail_, std::memory_order_release);
+    }
+
+    /**
+     * @brief Проверка на пустоту (корректна из потока потребителя)
+     */
+    bool Empty() const noexcept {
+        return tail_.load(std::memory_order_relaxed) == head_.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr size_t kCacheLineSize = 64;
+    static constexpr size_t kPrefixSize = sizeof(uint64_t);
+    static constexpr size_t kMinCapacity = 1024;
+    static constexpr uint64_t kWrapMarker = ~uint64_t{0};
+
+    static constexpr size_t Align(const size_t size) noexcept {
+        return (size + kPrefixSize - 1) & ~(kPrefixSize - 1);
+    }
+
+    static size_t RoundUpToPowerOfTwo(const size_t value) noexcept {
+        size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    void StorePrefix(const size_t offset, const uint64_t value) noexcept {
+        std::memcpy(buffer_.get() + offset, &value, sizeof(value));
+    }
+
+    uint64_t LoadPrefix(const size_t offset) const noexcept {
+        uint64_t value;
+        std::memcpy(&value, buffer_.get() + offset, sizeof(value));
+        return value;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    const std::unique_ptr<char[]> buffer_;
+
+    /// @brief Позиция записи и локальные данные производителя
+    alignas(kCacheLineSize) std::atomic<size_t> head_{0};
+    size_t pending_head_{0};
+    size_t cached_tail_{0};
+
+    /// @brief Позиция чтения и локальные данные потребителя
+    alignas(kCacheLineSize) std::atomic<size_t> tail_{0};
+    size_t pending_tail_{0};
+    size_t cached_head_{0};
+};
+
+} // namespace nexus::utils
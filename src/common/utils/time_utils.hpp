@@ -2,32 +2,69 @@
 
 #include <time.h>
 
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
 namespace nexus::utils::time {
 
+// Размер буфера для FormatTo: "YYYY-MM-DD HH:MM:SS.mmm" и завершающий ноль
+constexpr size_t kTimeStringSize = 32;
+
 inline timespec GetCurrentTime() {
     timespec ts{};
     clock_gettime(CLOCK_REALTIME, &ts);
     return ts;
 }
 
+// Системное время с точностью до тика таймера: дешевле GetCurrentTime() для частых проверок
+inline timespec GetCoarseTime() {
+    timespec ts{};
+#ifdef CLOCK_REALTIME_COARSE
+    clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+#else
+    clock_gettime(CLOCK_REALTIME, &ts);
+#endif
+    return ts;
+}
+
 inline timespec GetMonotonicTime() {
     timespec ts{};
     clock_gettime(CLOCK_MONOTONIC, &ts);
     return ts;
 }
 
-inline std::string ToString(const timespec& ts) {
+// Монотонное время с точностью до тика таймера
+inline timespec GetCoarseMonotonicTime() {
+    timespec ts{};
+#ifdef CLOCK_MONOTONIC_COARSE
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return ts;
+}
+
+// Форматирование времени в буфер вызывающего без выделения памяти
+// Возвращает длину записанной строки (без завершающего нуля)
+inline size_t FormatTo(const timespec& ts, char (&buffer)[kTimeStringSize]) {
     tm time_info{};
     localtime_r(&ts.tv_sec, &time_info);
 
-    char time_buffer[100];
-    strftime(time_buffer, sizeof(time_buffer), "%Y-%m-%d %H:%M:%S",
-             &time_info);
+    size_t length = strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S",
+                             &time_info);
 
-    char ms_buffer[10];
-    snprintf(ms_buffer, sizeof(ms_buffer), ".%03ld", ts.tv_nsec / 1000000);
+    const int written = snprintf(buffer + length, sizeof(buffer) - length, ".%03ld",
+                                 ts.tv_nsec / 1000000);
+    if (written > 0) {
+        length += static_cast<size_t>(written);
+    }
+    return length;
+}
 
-    return std::string(time_buffer) + std::string(ms_buffer);
+inline std::string ToString(const timespec& ts) {
+    char time_buffer[kTimeStringSize];
+    return std::string(time_buffer, FormatTo(ts, time_buffer));
 }
 
 // Преобразование timespec в миллисекунды (для интервалов)
@@ -35,6 +72,19 @@ inline int64_t ToMilliseconds(const timespec& ts) {
     return ts.tv_sec * 1000LL + ts.tv_nsec / 1000000LL;
 }
 
+// Преобразование timespec в наносекунды (для интервалов и монотонного времени)
+inline uint64_t ToNanoseconds(const timespec& ts) {
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+// Обратное преобразование наносекунд в timespec
+inline timespec FromNanoseconds(const uint64_t nanoseconds) {
+    timespec ts{};
+    ts.tv_sec = static_cast<time_t>(nanoseconds / 1000000000ULL);
+    ts.tv_nsec = static_cast<long>(nanoseconds % 1000000000ULL);
+    return ts;
+}
+
 // Разница между двумя временными метками
 inline timespec TimeDifference(const timespec& start, const timespec& end) {
     timespec diff{};
@@ -0,0 +1,161 @@
+#pragma once
+
+/**
+ * @file timestamp_formatter.hpp
+ * @brief Форматирование временных меток с кэшированием по секундам
+ */
+
+#include <time.h>
+
+#include <cstdint>
+#include <cstring>
+
+// Utils
+#include "capture_clock.hpp"
+#include "time_utils.hpp"
+
+namespace nexus::utils::time {
+
+/**
+ * @brief Источник и представление временной метки
+ */
+enum class TimestampClock {
+    LOCAL,    ///< Местное время: "YYYY-MM-DD HH:MM:SS.mmm"
+    UTC,      ///< Всемирное время: "YYYY-MM-DD HH:MM:SS.mmm"
+    MONOTONIC ///< Секунды CLOCK_MONOTONIC: "SSSSS.mmm"
+};
+
+/**
+ * @brief Точность дробной части секунды
+ */
+enum class TimestampPrecision {
+    MILLISECONDS,
+    MICROSECONDS
+};
+
+// Запись числа фиксированной ширины с ведущими нулями
+// Число итераций известно при компиляции, цикл разворачивается без ветвлений
+template <size_t Width>
+inline void WriteDigits(char* out, uint32_t value) noexcept {
+    for (size_t i = Width; i > 0; --i) {
+        out[i - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+/**
+ * @class TimestampFormatter
+ * @brief Форматирование временных меток без localtime_r/strftime на каждое сообщение
+ *
+ * Префикс до секунд включительно вычисляется один раз за секунду и кэшируется,
+ * для каждой метки дописываются только миллисекунды или микросекунды.
+ *
+ * @note Не потокобезопасен: экземпляр используется одним потоком
+ */
+class TimestampFormatter {
+public:
+    explicit TimestampFormatter(TimestampClock clock = TimestampClock::LOCAL,
+                                TimestampPrecision precision = TimestampPrecision::MILLISECONDS)
+        : clock_(clock), precision_(precision) {
+    }
+
+    /**
+     * @brief Текущее время по часам, соответствующим режиму
+     */
+    timespec Now() const noexcept {
+        return clock_ == TimestampClock::MONOTONIC ? GetMonotonicTime() : GetCurrentTime();
+    }
+
+    /**
+     * @brief Метка CaptureTicks(), снятая клиентом, в часах режима
+     * @param calibration Калибровка меток на узле логгера
+     * @param ticks Метка клиента
+     */
+    timespec FromCapture(const CaptureCalibration& calibration,
+                         const uint64_t ticks) const noexcept {
+        return FromNanoseconds(clock_ == TimestampClock::MONOTONIC
+                                   ? calibration.ToMonotonic(ticks)
+                                   : calibration.ToRealTime(ticks));
+    }
+
+    /**
+     * @brief Форматирование метки в буфер вызывающего
+     * @param ts Временная метка
+     * @param buffer Буфер для результата
+     * @return Длина записанной строки (без завершающего нуля)
+     */
+    size_t Format(const timespec& ts, char (&buffer)[kTimeStringSize]) noexcept {
+        if (ts.tv_sec != cached_second_) {
+            UpdatePrefix(ts.tv_sec);
+        }
+
+        std::memcpy(buffer, prefix_, prefix_length_);
+        char* out = buffer + prefix_length_;
+        *out++ = '.';
+
+        const auto nanoseconds = static_cast<uint32_t>(ts.tv_nsec);
+        if (precision_ == TimestampPrecision::MICROSECONDS) {
+            WriteDigits<6>(out, nanoseconds / 1000);
+            out += 6;
+        } else {
+            WriteDigits<3>(out, nanoseconds / 1000000);
+            out += 3;
+        }
+
+        *out = '\0';
+        return static_cast<size_t>(out - buffer);
+    }
+
+private:
+    void UpdatePrefix(const time_t second) noexcept {
+        cached_second_ = second;
+
+        if (clock_ == TimestampClock::MONOTONIC) {
+            // Секунды переменной ширины, как минимум одна цифра
+            char digits[24];
+            size_t count = 0;
+            auto value = static_cast<uint64_t>(second);
+            do {
+                digits[count++] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value != 0);
+
+            for (size_t i = 0; i < count; ++i) {
+                prefix_[i] = digits[count - 1 - i];
+            }
+            prefix_length_ = count;
+            return;
+        }
+
+        tm time_info{};
+        if (clock_ == TimestampClock::UTC) {
+            gmtime_r(&second, &time_info);
+        } else {
+            localtime_r(&second, &time_info);
+        }
+
+        // YYYY-MM-DD HH:MM:SS
+        WriteDigits<4>(prefix_, static_cast<uint32_t>(time_info.tm_year + 1900));
+        prefix_[4] = '-';
+        WriteDigits<2>(prefix_ + 5, static_cast<uint32_t>(time_info.tm_mon + 1));
+        prefix_[7] = '-';
+        WriteDigits<2>(prefix_ + 8, static_cast<uint32_t>(time_info.tm_mday));
+        prefix_[10] = ' ';
+        WriteDigits<2>(prefix_ + 11, static_cast<uint32_t>(time_info.tm_hour));
+        prefix_[13] = ':';
+        WriteDigits<2>(prefix_ + 14, static_cast<uint32_t>(time_info.tm_min));
+        prefix_[16] = ':';
+        WriteDigits<2>(prefix_ + 17, static_cast<uint32_t>(time_info.tm_sec));
+        prefix_length_ = 19;
+    }
+
+    TimestampClock clock_;
+    TimestampPrecision precision_;
+
+    /// @brief Секунда, для которой вычислен префикс (-1 - кэш пуст)
+    time_t cached_second_{-1};
+    char prefix_[24]{};
+    size_t prefix_length_{0};
+};
+
+} // namespace nexus::utils::time
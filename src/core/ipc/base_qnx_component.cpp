@@ -19,37 +19,17 @@ bool IsValidServerName(const std::string& server_name) {
 } // namespace
 
 namespace nexus::ipc {
-BaseQnxComponent::BaseQnxComponent(const std::string& server_name) {
+BaseQnxComponent::BaseQnxComponent(const std::string& server_name)
+    : server_name_(server_name) {
     // Валидация имени сервера
     if (!IsValidServerName(server_name)) {
         throw std::invalid_argument("Invalid server name");
     }
 
     // Регистрация имени в пространстве имен
-    attach_ = name_attach(nullptr, server_name.c_str(), 0);
-    if (attach_ == nullptr) {
-        throw std::system_error(errno, std::system_category());
-    }
+    channel_ = Channel::Attach(server_name);
 }
 
-
-BaseQnxComponent::~BaseQnxComponent() {
-    if (!attach_) {
-        return;
-    }
-
-    try {
-        // Отправка пульса для разблокировки ожидающих потоков
-        if (attach_->chid != -1) {
-            MsgSendPulse(attach_->chid, getprio(0), _PULSE_CODE_UNBLOCK, 0);
-        }
-
-        // Отсоединение имени от пространства имен
-        name_detach(attach_, 0);
-    } catch (...) {
-        // Гарантия отсутствия исключений в деструкторе
-    }
-
-    attach_ = nullptr;
-}
+// Канал отсоединяет имя при разрушении
+BaseQnxComponent::~BaseQnxComponent() = default;
 } // namespace nexus::common::ipc
\ No newline at end of file
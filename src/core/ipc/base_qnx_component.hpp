@@ -7,11 +7,12 @@
 
 #include <string>
 #include <algorithm>
+#include <memory>
 #include <stdexcept>
 #include <system_error>
 
-// QNX headers
-#include <sys/dispatch.h>
+// Transport
+#include "transport.hpp"
 
 namespace nexus::ipc {
 
@@ -20,7 +21,9 @@ namespace nexus::ipc {
  * @brief Базовый класс для компонентов, использующих QNX IPC
  *
  * Обеспечивает управление жизненным циклом IPC-каналов и валидацию имен серверов.
- * Использует RAII для безопасного управления ресурсами.
+ * Использует RAII для безопасного управления ресурсами. Канал создается через
+ * переносимый транспорт (см. transport.hpp): на QNX это name_attach, на Linux -
+ * сокет AF_UNIX SOCK_SEQPACKET.
  */
 
 class BaseQnxComponent {
@@ -42,15 +45,26 @@ public:
     BaseQnxComponent& operator=(BaseQnxComponent&&) = delete;
 
     /**
-     * @brief Получить указатель на структуру присоединенного имени
-     * @return Константный указатель на name_attach_t
+     * @brief Получить канал, зарегистрированный под именем сервера
+     * @return Ссылка на канал
      */
-    const name_attach_t* GetAttach() const noexcept {
-        return attach_;
+    Channel& GetChannel() const noexcept {
+        return *channel_;
+    }
+
+    /**
+     * @brief Получить имя, под которым зарегистрирован сервер
+     * @return Константная ссылка на имя сервера
+     */
+    const std::string& GetServerName() const noexcept {
+        return server_name_;
     }
 
 protected:
-    name_attach_t* attach_{nullptr};
+    std::unique_ptr<Channel> channel_;
+
+private:
+    const std::string server_name_;
 };
 
 } // namespace nexus::ipc
\ No newline at end of file
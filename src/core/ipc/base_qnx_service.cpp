@@ -1,8 +1,25 @@
 #include "base_qnx_service.hpp"
 
+#include <signal.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+// Types
+#include "../../common/types/pulse_types.hpp"
+
 namespace nexus::ipc {
+namespace {
+// Емкость буфера длинных сообщений, сохраняемая потоком приема между сообщениями
+constexpr size_t kRetainedPayload = 64 * 1024;
+} // namespace
+
 // Инициализация статических членов
 std::atomic<bool> BaseQnxService::shutdown_requested_{false};
+thread_local uint64_t BaseQnxService::receive_sequence_{0};
+thread_local bool BaseQnxService::replied_{false};
 
 BaseQnxService::BaseQnxService(const std::string& server_name)
     : BaseQnxComponent(server_name), running_{false} {
@@ -20,6 +37,30 @@ BaseQnxService::BaseQnxService(const std::string& server_name)
         throw std::system_error(errno, std::system_category(),
                                 "Failed to set SIGTERM handler");
     }
+
+    // Соединение с собственным каналом для пульсов пробуждения и таймеров
+    self_coid_ = GetChannel().ConnectSelf();
+    if (self_coid_ == -1) {
+        throw std::system_error(errno, std::system_category(),
+                                "Failed to connect to own channel");
+    }
+}
+
+BaseQnxService::~BaseQnxService() {
+    // Таймеры останавливаются до закрытия соединения, в которое они отправляют пульсы
+    timers_.clear();
+
+    if (self_coid_ != -1) {
+        Disconnect(self_coid_);
+    }
+}
+
+void BaseQnxService::SetReceiveThreads(const size_t count) {
+    receive_threads_ = std::max<size_t>(count, 1);
+}
+
+void BaseQnxService::StartPulseTimer(const int code, const std::chrono::milliseconds period) {
+    timers_.emplace_back(self_coid_, code, period);
 }
 
 void BaseQnxService::Run() {
@@ -27,18 +68,68 @@ void BaseQnxService::Run() {
         throw std::runtime_error("Service is already running");
     }
 
+    next_receive_sequence_.store(0, std::memory_order_relaxed);
+
+    std::vector<std::thread> pool;
+    try {
+        pool.reserve(receive_threads_ - 1);
+        for (size_t i = 1; i < receive_threads_; ++i) {
+            pool.emplace_back(&BaseQnxService::ReceiveLoop, this);
+        }
+    } catch (...) {
+        Stop();
+        for (auto& thread : pool) {
+            thread.join();
+        }
+        throw;
+    }
+
+    // Текущий поток - один из потоков пула
+    ReceiveLoop();
+
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+void BaseQnxService::ReceiveLoop() {
+    // Буфер не обнуляется: обработчик получает только принятые байты
+    IpcBuffer buffer;
+    std::vector<char> storage;
+
     while (running_.load(std::memory_order_acquire) &&
            !shutdown_requested_.load(std::memory_order_acquire)) {
-        IpcBuffer buffer{};
+        ReceiveInfo info{};
 
-        const int rcvid =
-            MsgReceive(GetAttach()->chid, &buffer, sizeof(buffer), nullptr);
+        const int rcvid = GetChannel().Receive(&buffer, sizeof(buffer), info);
 
         if (rcvid == 0) {
+            if (buffer.ipc_pulse.code == PULSE_WAKEUP) {
+                continue;
+            }
+            receive_sequence_ = NextReceiveSequence();
             HandlePulse(buffer.ipc_pulse);
         } else if (rcvid > 0) {
-            HandleMessage(rcvid, buffer.ipc_message);
-            MsgReply(rcvid, 0, nullptr, 0);
+            receive_sequence_ = NextReceiveSequence();
+
+            std::string_view payload;
+            const int error = ReadPayload(rcvid, buffer.ipc_message, info.length, storage,
+                                          payload);
+            if (error != 0) {
+                HandleReceiveError(error);
+                GetChannel().Error(rcvid, error);
+                continue;
+            }
+
+            replied_ = false;
+            HandleMessage(rcvid, info, buffer.ipc_message.header, payload);
+            if (!replied_) {
+                GetChannel().Reply(rcvid, 0);
+            }
+
+            if (storage.capacity() > kRetainedPayload) {
+                std::vector<char>().swap(storage);
+            }
         } else {
             // Если ошибка EINTR (прервано сигналом)
             if (errno == EINTR) {
@@ -46,21 +137,78 @@ void BaseQnxService::Run() {
                     Stop();
                 }
             } else {
-                HandleReceiveError(errno);
+                const int error = errno;
+                receive_sequence_ = NextReceiveSequence();
+                HandleReceiveError(error);
             }
         }
     }
 }
 
+int BaseQnxService::ReadPayload(const int receive_id, const IpcMessage& message,
+                                const size_t received, std::vector<char>& storage,
+                                std::string_view& payload) {
+    if (received < sizeof(MessageHeader)) {
+        return EBADMSG;
+    }
+    if (message.header.version != kProtocolVersion) {
+        return EPROTO;
+    }
+
+    const size_t length = message.header.length;
+    if (length > kMaxPayloadSize) {
+        return EMSGSIZE;
+    }
+
+    const size_t in_buffer = received - sizeof(MessageHeader);
+    if (length <= in_buffer) {
+        payload = {message.text, length};
+        return 0;
+    }
+
+    // Остаток дочитывается в буфер потока; он растет только при увеличении длины,
+    // поэтому новые байты обнуляются лишь при росте
+    if (storage.size() < length) {
+        storage.resize(length);
+    }
+    std::memcpy(storage.data(), message.text, in_buffer);
+
+    size_t total = in_buffer;
+    while (total < length) {
+        const int read = GetChannel().Read(receive_id, storage.data() + total, length - total,
+                                           sizeof(MessageHeader) + total);
+        if (read < 0) {
+            return errno;
+        }
+        if (read == 0) {
+            // Отправитель передал меньше, чем указал в заголовке
+            return EBADMSG;
+        }
+        total += static_cast<size_t>(read);
+    }
+
+    payload = {storage.data(), length};
+    return 0;
+}
+
+bool BaseQnxService::ReplyMessage(const int receive_id, const int status, const void* data,
+                                  const size_t size) {
+    replied_ = true;
+    return GetChannel().Reply(receive_id, status, data, size);
+}
+
 void BaseQnxService::Stop() {
     if (!running_.exchange(false)) {
         return; // Уже остановлен
     }
 
-    // Отправляем пульс, чтобы разблокировать MsgReceive
-    if (GetAttach() && GetAttach()->chid != -1) {
-        MsgSendPulse(GetAttach()->chid, getprio(0), _PULSE_CODE_UNBLOCK, 0);
-    }
+    // Отправляем по пульсу на каждый поток пула, чтобы разблокировать Receive().
+    // Поток, получивший пульс, выходит из цикла и больше не принимает сообщения
+    SendPulses(self_coid_, CurrentPriority(), PULSE_WAKEUP, 0, receive_threads_);
+}
+
+uint64_t BaseQnxService::NextReceiveSequence() noexcept {
+    return next_receive_sequence_.fetch_add(1, std::memory_order_relaxed);
 }
 
 void BaseQnxService::SignalHandler(int signal) {
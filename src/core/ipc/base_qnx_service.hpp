@@ -3,9 +3,14 @@
 /**
  * @file base_qnx_service.hpp
  * @brief Базовый сервис для обработки IPC сообщений и пульсов в QNX
+ *
+ * Работает поверх переносимого транспорта (transport.hpp) и собирается также на Linux.
  */
 
 #include <atomic>
+#include <chrono>
+#include <string_view>
+#include <vector>
 
 // Base
 #include "base_qnx_component.hpp"
@@ -22,6 +27,11 @@ namespace nexus::ipc {
  * Предоставляет основной цикл обработки сообщений, управление жизненным циклом
  * сервиса и обработку сигналов для graceful shutdown.
  * Наследники должны реализовать обработку конкретных типов сообщений и пульсов.
+ *
+ * Сообщение принимается в буфер размера kReceiveBufferSize: заголовок MessageHeader
+ * и начало данных. Данные, не поместившиеся в буфер, дочитываются по длине из
+ * заголовка в буфер потока приема, который переиспользуется следующими сообщениями.
+ * Сообщения другой версии протокола или с неверной длиной отклоняются ошибкой.
  */
 class BaseQnxService : public BaseQnxComponent {
 public:
@@ -35,14 +45,18 @@ public:
 
     /**
      * @brief Виртуальный деструктор для корректного удаления наследников
+     *
+     * Удаляет таймеры, созданные StartPulseTimer().
      */
-    ~BaseQnxService() override = default;
+    ~BaseQnxService() override;
 
     /**
      * @brief Запуск основного цикла обработки сообщений
      *
      * Метод блокирует выполнение до вызова Stop() или получения сигнала завершения.
-     * В цикле обрабатываются входящие сообщения и пульсы.
+     * В цикле обрабатываются входящие сообщения и пульсы. При числе потоков приема
+     * больше одного дополнительные потоки создаются здесь же и присоединяются
+     * перед возвратом.
      *
      * @throw std::system_error При ошибках в IPC механизмах
      */
@@ -51,14 +65,80 @@ public:
     /**
      * @brief Остановка сервиса и выход из цикла обработки
      *
-     * Атомарно устанавливает флаг остановки и отправляет пульс для разблокировки
-     * потока, ожидающего сообщения в MsgReceive().
+     * Атомарно устанавливает флаг остановки и отправляет по пульсу на каждый
+     * поток приема, ожидающий сообщения в MsgReceive().
      *
      * @note Потокобезопасность: thread-safe, может вызываться из любого потока
      */
     void Stop();
 
+    /**
+     * @brief Настройка числа потоков приема на канале
+     * @param count Число потоков, вызывающих MsgReceive (не меньше 1)
+     *
+     * Каждое принятое событие получает глобальный порядковый номер приема,
+     * доступный обработчику через CurrentReceiveSequence(). Обработчики
+     * вызываются параллельно и должны быть потокобезопасными.
+     *
+     * @note Должен вызываться до Run()
+     */
+    void SetReceiveThreads(size_t count);
+
+protected:
+    /**
+     * @brief Порядковый номер события, обрабатываемого текущим потоком
+     *
+     * Номера выдаются сразу после возврата из MsgReceive, начинаются с нуля при
+     * каждом запуске Run() и идут без пропусков: каждый номер соответствует
+     * ровно одному вызову HandlePulse(), HandleMessage() или HandleReceiveError().
+     */
+    static uint64_t CurrentReceiveSequence() noexcept {
+        return receive_sequence_;
+    }
+
+    /**
+     * @brief Запуск периодического пульса в собственный канал сервиса
+     * @param code Код пульса, который получит HandlePulse()
+     * @param period Период срабатывания таймера
+     *
+     * Пульс доставляется через соединение с собственным каналом,
+     * поэтому обрабатывается тем же циклом Run(), что и остальные сообщения.
+     *
+     * @throw std::system_error При ошибках создания соединения или таймера
+     */
+    void StartPulseTimer(int code, std::chrono::milliseconds period);
+
+    /**
+     * @brief Ответ клиенту с данными из HandleMessage()
+     * @param receive_id Идентификатор, переданный в HandleMessage()
+     * @param status Статус, который вернет Send() у клиента
+     * @param data Данные ответа
+     * @param size Размер данных ответа
+     * @return false при ошибке, код в errno
+     *
+     * После такого ответа цикл приема не отправляет пустой ответ по умолчанию.
+     */
+    bool ReplyMessage(int receive_id, int status, const void* data, size_t size);
+
 private:
+    /// @brief Цикл приема одного потока пула
+    void ReceiveLoop();
+
+    /**
+     * @brief Проверка заголовка и сборка данных сообщения
+     * @param receive_id Идентификатор принятого сообщения
+     * @param message Буфер приема
+     * @param received Число байт в буфере приема
+     * @param storage Буфер потока для данных, не поместившихся в буфер приема
+     * @param payload [out] Данные сообщения
+     * @return 0 или код ошибки для ответа клиенту
+     */
+    int ReadPayload(int receive_id, const IpcMessage& message, size_t received,
+                    std::vector<char>& storage, std::string_view& payload);
+
+    /// @brief Выдача следующего порядкового номера приема
+    uint64_t NextReceiveSequence() noexcept;
+
     /**
      * @brief Обработка входящих пульсов
      * @param ipc_pulse Ссылка на структуру пульса
@@ -66,16 +146,19 @@ private:
      * Виртуальный метод для обработки системных и пользовательских пульсов.
      * Наследники должны реализовать специфичную логику обработки.
      */
-    virtual void HandlePulse(const _pulse& ipc_pulse) = 0;
+    virtual void HandlePulse(const Pulse& ipc_pulse) = 0;
 
     /**
      * @brief Обработка входящих IPC сообщений
-     * @param ipc_message Ссылка на IPC сообщение
+     * @param info Отправитель сообщения по сведениям транспорта (pid, tid, scoid)
+     * @param header Проверенный заголовок сообщения
+     * @param payload Данные сообщения целиком (действительны до возврата)
      *
      * Виртуальный метод для обработки структурированных сообщений.
      * Наследники должны реализовать маршрутизацию и обработку разных типов сообщений.
      */
-    virtual void HandleMessage(int receive_id, const IpcMessage& ipc_message) = 0;
+    virtual void HandleMessage(int receive_id, const ReceiveInfo& info,
+                               const MessageHeader& header, std::string_view payload) = 0;
 
     /**
      * @brief Обработка ошибок приема сообщений
@@ -89,6 +172,22 @@ private:
     /// @brief Атомарный флаг состояния работы сервиса
     std::atomic<bool> running_;
 
+    /// @brief Соединение с собственным каналом для пульсов пробуждения и таймеров
+    int self_coid_{-1};
+
+    /// @brief Число потоков приема
+    size_t receive_threads_{1};
+
+    /// @brief Счетчик порядковых номеров приема и номер события текущего потока
+    std::atomic<uint64_t> next_receive_sequence_{0};
+    static thread_local uint64_t receive_sequence_;
+
+    /// @brief Обработчик текущего сообщения уже ответил клиенту сам
+    static thread_local bool replied_;
+
+    /// @brief Таймеры, созданные StartPulseTimer()
+    std::vector<PulseTimer> timers_;
+
     /// @brief Статический атомарный флаг запроса завершения для всех экземпляров
     static std::atomic<bool> shutdown_requested_;
 
@@ -0,0 +1,713 @@
+#include "transport.hpp"
+
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace nexus::ipc {
+
+namespace {
+// Число датаграмм, забираемых из соединения одним recvmmsg
+constexpr size_t kReceiveBatch = 16;
+
+// Наибольший размер данных одного кадра. Более длинное сообщение клиент передает
+// несколькими кадрами подряд, сервер собирает их до передачи вызывающему
+constexpr size_t kFrameSize = 8192;
+
+// Время ожидания следующего кадра сообщения, после которого соединение закрывается
+constexpr int kFrameTimeoutMs = 1000;
+
+// Емкость буфера непрочитанных данных, сохраняемая потоком между сообщениями
+constexpr size_t kRetainedUnread = 64 * 1024;
+
+// Максимальное число частей сообщения в одном sendmsg
+constexpr size_t kMaxIov = 16;
+
+// Число блокировок, сериализующих запрос-ответ на соединениях клиента
+constexpr size_t kSendLocks = 64;
+
+/**
+ * @brief Вид кадра в сокете
+ */
+enum class FrameType : uint8_t {
+    MESSAGE = 1, ///< Сообщение клиента, ждущее ответа
+    PULSE = 2,   ///< Пульс без ответа
+    REPLY = 3    ///< Ответ сервера на сообщение
+};
+
+/**
+ * @brief Флаги кадра
+ */
+enum FrameFlags : uint16_t {
+    FRAME_MORE = 0x0001, ///< Сообщение продолжается в следующем кадре
+    FRAME_ERROR = 0x0002 ///< Ответ-ошибка: value содержит код errno
+};
+
+#pragma pack(push, 1)
+// Заголовок кадра, за ним следуют данные сообщения или ответа
+struct FrameHeader {
+    FrameType type;
+    int8_t code;
+    uint16_t flags;
+    int32_t value; ///< Значение пульса, статус ответа или поток отправителя сообщения
+};
+#pragma pack(pop)
+
+/**
+ * @brief Часть сообщения, принятого потоком, не поместившаяся в буфер Receive()
+ *
+ * Хранится до ответа отправителю и отдается через Channel::Read(), как MsgRead на QNX.
+ */
+struct Unread {
+    int receive_id{-1};
+    size_t offset{0}; ///< Смещение data от начала сообщения
+    std::vector<char> data;
+};
+
+thread_local Unread unread;
+
+// Освобождение непрочитанных данных после ответа; небольшой буфер остается потоку
+void ReleaseUnread(const int receive_id) {
+    if (unread.receive_id != receive_id) {
+        return;
+    }
+    unread.receive_id = -1;
+    if (unread.data.capacity() > kRetainedUnread) {
+        std::vector<char>().swap(unread.data);
+    } else {
+        unread.data.clear();
+    }
+}
+
+// Адрес канала в абстрактном пространстве имен: файл в ФС не создается
+// и не остается после аварийного завершения сервера
+sockaddr_un MakeAddress(const std::string& name, socklen_t& length) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    const std::string path = "nexus/" + name;
+    const size_t size = std::min(path.size(), sizeof(address.sun_path) - 1);
+    std::memcpy(address.sun_path + 1, path.data(), size);
+    length = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + 1 + size);
+    return address;
+}
+
+// Соединения с одинаковым остатком используют одну блокировку: запрос и ответ
+// одного соединения не должны перемежаться с запросами других потоков
+std::mutex& SendLock(const int connection_id) {
+    static std::mutex locks[kSendLocks];
+    return locks[static_cast<size_t>(connection_id) % kSendLocks];
+}
+
+// Блокировка записи кадров: пульс не должен попасть между кадрами сообщения.
+// Держится только на время записи, поэтому пульс не ждет ответа на чужой запрос
+std::mutex& FrameLock(const int connection_id) {
+    static std::mutex locks[kSendLocks];
+    return locks[static_cast<size_t>(connection_id) % kSendLocks];
+}
+
+// Данные epoll для соединения: дескриптор и pid клиента
+uint64_t PackPeer(const int fd, const int32_t pid) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(pid)) << 32 | static_cast<uint32_t>(fd);
+}
+
+int PeerFd(const uint64_t data) {
+    return static_cast<int>(data & 0xFFFFFFFFu);
+}
+
+int32_t PeerPid(const uint64_t data) {
+    return static_cast<int32_t>(data >> 32);
+}
+} // namespace
+
+struct Channel::Impl {
+    /**
+     * @brief Датаграмма, принятая в составе пачки и ждущая своего потока
+     */
+    struct Pending {
+        uint64_t peer;
+        FrameHeader header;
+        std::vector<char> payload;
+    };
+
+    ~Impl() {
+        for (const int fd : connections) {
+            close(fd);
+        }
+        close(event_fd);
+        close(epoll_fd);
+        close(listen_fd);
+    }
+
+    /// @brief Прием всех ожидающих подключений
+    void Accept();
+
+    /// @brief Повторное включение уведомлений о соединении (EPOLLONESHOT)
+    void Rearm(uint64_t peer) const;
+
+    /// @brief Удаление закрытого клиентом соединения
+    void Close(int fd);
+
+    /// @brief Передача принятой датаграммы другому потоку Receive()
+    void Post(Pending&& item);
+
+    /**
+     * @brief Синхронный прием следующего кадра сообщения, не попавшего в пачку
+     * @param header [out] Заголовок кадра
+     * @param data Данные кадра дописываются в конец
+     * @return false, если соединение закрыто или кадр не пришел за kFrameTimeoutMs
+     */
+    static bool ReadFrame(int fd, FrameHeader& header, std::vector<char>& data);
+
+    /// @brief Сведения о событии для вызывающего; length - байт в его буфере
+    static int Deliver(uint64_t peer, const FrameHeader& header, void* buffer, size_t length,
+                       ReceiveInfo& info);
+
+    std::string name;
+    int listen_fd{-1};
+    int epoll_fd{-1};
+
+    /// @brief Счетчик-семафор ожидающих датаграмм: каждое значение - одна запись pending
+    int event_fd{-1};
+
+    std::mutex mutex;
+    std::deque<Pending> pending;
+    std::vector<int> connections;
+};
+
+void Channel::Impl::Accept() {
+    for (;;) {
+        const int fd = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
+        if (fd == -1) {
+            return;
+        }
+
+        ucred credentials{};
+        socklen_t credentials_size = sizeof(credentials);
+        getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &credentials_size);
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLONESHOT;
+        event.data.u64 = PackPeer(fd, credentials.pid);
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == -1) {
+            close(fd);
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        connections.push_back(fd);
+    }
+}
+
+void Channel::Impl::Rearm(const uint64_t peer) const {
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.u64 = peer;
+    epoll_ctl(epoll_fd, EPOLL_CTL_MOD, PeerFd(peer), &event);
+}
+
+void Channel::Impl::Close(const int fd) {
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    connections.erase(std::remove(connections.begin(), connections.end(), fd),
+                      connections.end());
+    close(fd);
+}
+
+void Channel::Impl::Post(Pending&& item) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(std::move(item));
+    }
+    const uint64_t one = 1;
+    write(event_fd, &one, sizeof(one));
+}
+
+bool Channel::Impl::ReadFrame(const int fd, FrameHeader& header, std::vector<char>& data) {
+    const size_t size = data.size();
+    data.resize(size + kFrameSize);
+
+    iovec iov[2] = {{&header, sizeof(header)}, {data.data() + size, kFrameSize}};
+    msghdr message{};
+    message.msg_iov = iov;
+    message.msg_iovlen = 2;
+
+    for (;;) {
+        const ssize_t received = recvmsg(fd, &message, MSG_DONTWAIT);
+        if (received >= static_cast<ssize_t>(sizeof(header))) {
+            data.resize(size + static_cast<size_t>(received) - sizeof(header));
+            return true;
+        }
+        if (received == -1 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            // Клиент еще отправляет сообщение: он держит соединение до ответа
+            pollfd poll_fd{fd, POLLIN, 0};
+            if (poll(&poll_fd, 1, kFrameTimeoutMs) > 0 || errno == EINTR) {
+                continue;
+            }
+        }
+        data.resize(size);
+        return false;
+    }
+}
+
+int Channel::Impl::Deliver(const uint64_t peer, const FrameHeader& header, void* buffer,
+                           const size_t length, ReceiveInfo& info) {
+    if (header.type == FrameType::PULSE) {
+        const Pulse pulse{header.code, header.value};
+        std::memcpy(buffer, &pulse, sizeof(pulse));
+        return 0;
+    }
+
+    info.length = length;
+    info.pid = PeerPid(peer);
+    info.tid = header.value;
+    info.scoid = PeerFd(peer);
+    return PeerFd(peer);
+}
+
+std::unique_ptr<Channel> Channel::Attach(const std::string& name) {
+    auto impl = std::make_unique<Impl>();
+    impl->name = name;
+
+    impl->listen_fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    impl->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    impl->event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK | EFD_SEMAPHORE);
+    if (impl->listen_fd == -1 || impl->epoll_fd == -1 || impl->event_fd == -1) {
+        throw std::system_error(errno, std::system_category(),
+                                "cannot create channel: " + name);
+    }
+
+    socklen_t address_length = 0;
+    const sockaddr_un address = MakeAddress(name, address_length);
+    if (bind(impl->listen_fd, reinterpret_cast<const sockaddr*>(&address), address_length) == -1
+        || listen(impl->listen_fd, SOMAXCONN) == -1) {
+        throw std::system_error(errno, std::system_category(),
+                                "cannot attach channel: " + name);
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = PackPeer(impl->listen_fd, 0);
+    if (epoll_ctl(impl->epoll_fd, EPOLL_CTL_ADD, impl->listen_fd, &event) == -1) {
+        throw std::system_error(errno, std::system_category(),
+                                "cannot watch channel: " + name);
+    }
+
+    event.data.u64 = PackPeer(impl->event_fd, 0);
+    if (epoll_ctl(impl->epoll_fd, EPOLL_CTL_ADD, impl->event_fd, &event) == -1) {
+        throw std::system_error(errno, std::system_category(),
+                                "cannot watch channel: " + name);
+    }
+
+    return std::unique_ptr<Channel>(new Channel(std::move(impl)));
+}
+
+Channel::Channel(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {
+}
+
+Channel::~Channel() = default;
+
+int Channel::Receive(void* buffer, const size_t size, ReceiveInfo& info) {
+    // Буферы датаграмм пачки; первая датаграмма принимается в буфер вызывающего,
+    // а ее не поместившийся остаток - в буфер 0
+    thread_local std::vector<char> batch_buffers(kReceiveBatch * kFrameSize);
+
+    for (;;) {
+        // Датаграммы, принятые другим потоком в составе пачки
+        uint64_t token = 0;
+        if (read(impl_->event_fd, &token, sizeof(token)) == sizeof(token)) {
+            Impl::Pending item;
+            {
+                std::lock_guard<std::mutex> lock(impl_->mutex);
+                item = std::move(impl_->pending.front());
+                impl_->pending.pop_front();
+            }
+            const size_t length = std::min(item.payload.size(), size);
+            std::memcpy(buffer, item.payload.data(), length);
+
+            unread.receive_id = -1;
+            if (item.header.type == FrameType::MESSAGE && item.payload.size() > size) {
+                unread.receive_id = PeerFd(item.peer);
+                unread.offset = 0;
+                unread.data = std::move(item.payload);
+            }
+            return Impl::Deliver(item.peer, item.header, buffer, length, info);
+        }
+
+        epoll_event event{};
+        const int ready = epoll_wait(impl_->epoll_fd, &event, 1, -1);
+        if (ready == -1) {
+            return -1;
+        }
+        if (ready == 0) {
+            continue;
+        }
+
+        const int fd = PeerFd(event.data.u64);
+        if (fd == impl_->event_fd) {
+            continue;
+        }
+        if (fd == impl_->listen_fd) {
+            impl_->Accept();
+            continue;
+        }
+
+        FrameHeader headers[kReceiveBatch]{};
+        iovec iov[kReceiveBatch][3];
+        mmsghdr messages[kReceiveBatch]{};
+        for (size_t i = 0; i < kReceiveBatch; ++i) {
+            char* frame_buffer = batch_buffers.data() + i * kFrameSize;
+            iov[i][0] = {&headers[i], sizeof(FrameHeader)};
+            if (i == 0) {
+                iov[i][1] = {buffer, size};
+                iov[i][2] = {frame_buffer, kFrameSize};
+                messages[i].msg_hdr.msg_iovlen = 3;
+            } else {
+                iov[i][1] = {frame_buffer, kFrameSize};
+                messages[i].msg_hdr.msg_iovlen = 2;
+            }
+            messages[i].msg_hdr.msg_iov = iov[i];
+        }
+
+        const int count = recvmmsg(fd, messages, kReceiveBatch, MSG_DONTWAIT, nullptr);
+        if (count == -1 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            impl_->Rearm(event.data.u64);
+            continue;
+        }
+        if (count <= 0 || messages[0].msg_len < sizeof(FrameHeader)) {
+            // Клиент закрыл соединение
+            impl_->Close(fd);
+            continue;
+        }
+
+        // Кадры одного сообщения идут подряд: соединение читает только этот поток,
+        // а клиент не отправляет следующее сообщение до ответа на текущее.
+        // Следующий кадр берется из пачки, а после ее окончания - из сокета
+        int index = 1;
+        const auto next_frame = [&](FrameHeader& header, std::vector<char>& data) {
+            if (index >= count) {
+                return Impl::ReadFrame(fd, header, data);
+            }
+            const unsigned int length = messages[index].msg_len;
+            if (length < sizeof(FrameHeader)) {
+                return false;
+            }
+            header = headers[index];
+            const char* frame = static_cast<const char*>(iov[index][1].iov_base);
+            data.insert(data.end(), frame, frame + (length - sizeof(FrameHeader)));
+            ++index;
+            return true;
+        };
+
+        // Продолжение сообщения. Кадр не MESSAGE между кадрами сообщения возможен
+        // только от клиента без блокировки кадров: пульс передается другим потокам,
+        // остальное считается нарушением протокола и закрывает соединение
+        const auto next_part = [&](FrameHeader& header, std::vector<char>& data) {
+            for (;;) {
+                const size_t size = data.size();
+                if (!next_frame(header, data)) {
+                    return false;
+                }
+                if (header.type == FrameType::MESSAGE) {
+                    return true;
+                }
+                data.resize(size);
+                if (header.type != FrameType::PULSE) {
+                    return false;
+                }
+                impl_->Post({event.data.u64, header, {}});
+            }
+        };
+
+        // Первое сообщение: начало в буфере вызывающего, остальное - для Read()
+        const FrameHeader first = headers[0];
+        const size_t first_length = messages[0].msg_len - sizeof(FrameHeader);
+        const size_t in_buffer = std::min(first_length, size);
+
+        unread.receive_id = -1;
+        unread.offset = in_buffer;
+        unread.data.assign(batch_buffers.data(), batch_buffers.data() + (first_length - in_buffer));
+
+        bool closed = false;
+        FrameHeader header = first;
+        while (first.type == FrameType::MESSAGE && (header.flags & FRAME_MORE) != 0) {
+            if (!next_part(header, unread.data)) {
+                closed = true;
+                break;
+            }
+        }
+        const bool first_complete = !closed;
+
+        // Остальные сообщения пачки достаются другим потокам
+        while (!closed && index < count) {
+            Impl::Pending item{event.data.u64, {}, {}};
+            closed = !next_frame(item.header, item.payload);
+            header = item.header;
+            while (!closed && item.header.type == FrameType::MESSAGE
+                   && (header.flags & FRAME_MORE) != 0) {
+                closed = !next_part(header, item.payload);
+            }
+            if (closed) {
+                break;
+            }
+
+            impl_->Post(std::move(item));
+        }
+
+        if (closed) {
+            impl_->Close(fd);
+        } else {
+            impl_->Rearm(event.data.u64);
+        }
+
+        // Сообщение, оборванное закрытием соединения, не передается
+        if (first.type == FrameType::REPLY || !first_complete) {
+            continue;
+        }
+        if (first.type == FrameType::MESSAGE && !unread.data.empty()) {
+            unread.receive_id = fd;
+        }
+        return Impl::Deliver(event.data.u64, first, buffer, in_buffer, info);
+    }
+}
+
+int Channel::Read(const int receive_id, void* buffer, const size_t size, const size_t offset) {
+    if (unread.receive_id != receive_id || offset < unread.offset) {
+        // Сообщение целиком передано Receive()
+        return 0;
+    }
+
+    const size_t start = offset - unread.offset;
+    if (start >= unread.data.size()) {
+        return 0;
+    }
+    const size_t length = std::min(size, unread.data.size() - start);
+    std::memcpy(buffer, unread.data.data() + start, length);
+    return static_cast<int>(length);
+}
+
+bool Channel::Reply(const int receive_id, const int status, const void* data,
+                    const size_t size) {
+    ReleaseUnread(receive_id);
+
+    FrameHeader header{FrameType::REPLY, 0, 0, status};
+    iovec iov[2] = {{&header, sizeof(header)}, {const_cast<void*>(data), size}};
+
+    msghdr message{};
+    message.msg_iov = iov;
+    message.msg_iovlen = size > 0 ? 2 : 1;
+    return sendmsg(receive_id, &message, MSG_NOSIGNAL) != -1;
+}
+
+bool Channel::Error(const int receive_id, const int error) {
+    ReleaseUnread(receive_id);
+
+    const FrameHeader header{FrameType::REPLY, 0, FRAME_ERROR, error};
+    return send(receive_id, &header, sizeof(header), MSG_NOSIGNAL) != -1;
+}
+
+int Channel::ConnectSelf() {
+    return Connect(impl_->name);
+}
+
+struct PulseTimer::Impl {
+    ~Impl() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        stopped.notify_one();
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable stopped;
+    bool stop{false};
+    std::thread thread;
+};
+
+PulseTimer::PulseTimer(const int connection_id, const int code,
+                       const std::chrono::milliseconds period)
+    : impl_(std::make_unique<Impl>()) {
+    // Поток таймера отправляет пульс так же, как SIGEV_PULSE на QNX
+    try {
+        impl_->thread = std::thread([impl = impl_.get(), connection_id, code, period] {
+            auto next = std::chrono::steady_clock::now() + period;
+            std::unique_lock<std::mutex> lock(impl->mutex);
+            while (!impl->stopped.wait_until(lock, next, [impl] { return impl->stop; })) {
+                SendPulse(connection_id, CurrentPriority(), code, 0);
+                next += period;
+            }
+        });
+    } catch (const std::system_error& e) {
+        throw std::system_error(e.code(), "Failed to create pulse timer");
+    }
+}
+
+PulseTimer::~PulseTimer() = default;
+
+PulseTimer::PulseTimer(PulseTimer&&) noexcept = default;
+PulseTimer& PulseTimer::operator=(PulseTimer&&) noexcept = default;
+
+int Connect(const std::string& name) {
+    const int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd == -1) {
+        return -1;
+    }
+
+    socklen_t address_length = 0;
+    const sockaddr_un address = MakeAddress(name, address_length);
+    if (connect(fd, reinterpret_cast<const sockaddr*>(&address), address_length) == -1) {
+        const int error = errno;
+        close(fd);
+        errno = error;
+        return -1;
+    }
+    return fd;
+}
+
+void Disconnect(const int connection_id) {
+    close(connection_id);
+}
+
+int SendV(const int connection_id, const MessagePart* parts, const size_t part_count,
+          void* reply, const size_t reply_size) {
+    // Запрос и ответ соединения не перемежаются с запросами других потоков
+    std::lock_guard<std::mutex> lock(SendLock(connection_id));
+
+    // Сообщение режется на кадры не длиннее kFrameSize, части не склеиваются
+    std::unique_lock<std::mutex> frame_lock(FrameLock(connection_id));
+    size_t part = 0;
+    size_t part_offset = 0;
+    bool more = true;
+    while (more) {
+        FrameHeader header{FrameType::MESSAGE, 0, 0, CurrentThreadId()};
+        iovec iov[kMaxIov + 1];
+        iov[0] = {&header, sizeof(header)};
+        size_t iov_count = 1;
+        size_t frame_size = 0;
+
+        while (part < part_count && frame_size < kFrameSize && iov_count <= kMaxIov) {
+            const size_t length = std::min(parts[part].size - part_offset,
+                                           kFrameSize - frame_size);
+            if (length > 0) {
+                iov[iov_count] = {
+                    static_cast<char*>(const_cast<void*>(parts[part].data)) + part_offset, length
+                };
+                ++iov_count;
+                frame_size += length;
+                part_offset += length;
+            }
+            if (part_offset == parts[part].size) {
+                ++part;
+                part_offset = 0;
+            }
+        }
+
+        // Пустые части в конце не требуют еще одного кадра
+        while (part < part_count && parts[part].size == 0) {
+            ++part;
+        }
+        more = part < part_count;
+        if (more) {
+            header.flags = FRAME_MORE;
+        }
+
+        msghdr message{};
+        message.msg_iov = iov;
+        message.msg_iovlen = iov_count;
+        if (sendmsg(connection_id, &message, MSG_NOSIGNAL) == -1) {
+            return -1;
+        }
+    }
+    frame_lock.unlock();
+
+    // Ожидание ответа, как у MsgSend: клиент заблокирован до Reply() сервера
+    for (;;) {
+        FrameHeader reply_header{};
+        iovec reply_iov[2] = {{&reply_header, sizeof(reply_header)}, {reply, reply_size}};
+        msghdr reply_message{};
+        reply_message.msg_iov = reply_iov;
+        reply_message.msg_iovlen = reply_size > 0 ? 2 : 1;
+
+        const ssize_t received = recvmsg(connection_id, &reply_message, 0);
+        if (received == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        if (received == 0) {
+            errno = ECONNRESET;
+            return -1;
+        }
+        if (static_cast<size_t>(received) >= sizeof(reply_header)
+            && reply_header.type == FrameType::REPLY) {
+            if ((reply_header.flags & FRAME_ERROR) != 0) {
+                errno = reply_header.value;
+                return -1;
+            }
+            return reply_header.value;
+        }
+    }
+}
+
+bool SendPulse(const int connection_id, [[maybe_unused]] const int priority, const int code,
+               const int value) {
+    const FrameHeader header{FrameType::PULSE, static_cast<int8_t>(code), 0, value};
+    std::lock_guard<std::mutex> lock(FrameLock(connection_id));
+    return send(connection_id, &header, sizeof(header), MSG_NOSIGNAL) != -1;
+}
+
+bool SendPulses(const int connection_id, [[maybe_unused]] const int priority, const int code,
+                const int value, size_t count) {
+    const FrameHeader header{FrameType::PULSE, static_cast<int8_t>(code), 0, value};
+    iovec iov{const_cast<FrameHeader*>(&header), sizeof(header)};
+
+    mmsghdr messages[kReceiveBatch]{};
+    for (auto& message : messages) {
+        message.msg_hdr.msg_iov = &iov;
+        message.msg_hdr.msg_iovlen = 1;
+    }
+
+    std::lock_guard<std::mutex> lock(FrameLock(connection_id));
+    while (count > 0) {
+        const auto batch = static_cast<unsigned int>(std::min(count, kReceiveBatch));
+        const int sent = sendmmsg(connection_id, messages, batch, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            return false;
+        }
+        count -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+int CurrentPriority() {
+    // Приоритет пульсов на Linux не передается
+    return 0;
+}
+
+int32_t CurrentThreadId() {
+    // SO_PEERCRED сообщает только процесс, поток клиент передает в заголовке кадра
+    thread_local const auto tid = static_cast<int32_t>(syscall(SYS_gettid));
+    return tid;
+}
+
+} // namespace nexus::ipc
@@ -0,0 +1,179 @@
+#include "transport.hpp"
+
+#include <pthread.h>
+#include <time.h>
+
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+// QNX
+#include <sys/dispatch.h>
+#include <sys/neutrino.h>
+
+namespace nexus::ipc {
+
+static_assert(kPulseCodeMaxAvail == _PULSE_CODE_MAXAVAIL,
+              "Pulse codes must match the QNX application range");
+
+namespace {
+// Максимальное число частей сообщения в одном MsgSendv
+constexpr size_t kMaxIov = 16;
+} // namespace
+
+struct Channel::Impl {
+    name_attach_t* attach{nullptr};
+};
+
+std::unique_ptr<Channel> Channel::Attach(const std::string& name) {
+    auto impl = std::make_unique<Impl>();
+
+    // Регистрация имени в пространстве имен
+    impl->attach = name_attach(nullptr, name.c_str(), 0);
+    if (impl->attach == nullptr) {
+        throw std::system_error(errno, std::system_category(),
+                                "cannot attach channel: " + name);
+    }
+
+    return std::unique_ptr<Channel>(new Channel(std::move(impl)));
+}
+
+Channel::Channel(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {
+}
+
+Channel::~Channel() {
+    // Отсоединение имени от пространства имен
+    name_detach(impl_->attach, 0);
+}
+
+int Channel::Receive(void* buffer, const size_t size, ReceiveInfo& info) {
+    _msg_info msg_info{};
+    const int rcvid = MsgReceive(impl_->attach->chid, buffer, size, &msg_info);
+
+    if (rcvid == 0) {
+        // Переводим _pulse ядра в переносимое представление
+        _pulse kernel_pulse{};
+        std::memcpy(&kernel_pulse, buffer, sizeof(kernel_pulse));
+        const Pulse pulse{kernel_pulse.code, kernel_pulse.value.sival_int};
+        std::memcpy(buffer, &pulse, sizeof(pulse));
+    } else if (rcvid > 0) {
+        info.length = static_cast<size_t>(msg_info.msglen);
+        info.pid = msg_info.pid;
+        info.tid = msg_info.tid;
+        info.scoid = msg_info.scoid;
+    }
+    return rcvid;
+}
+
+int Channel::Read(const int receive_id, void* buffer, const size_t size, const size_t offset) {
+    return MsgRead(receive_id, buffer, size, offset);
+}
+
+bool Channel::Reply(const int receive_id, const int status, const void* data,
+                    const size_t size) {
+    return MsgReply(receive_id, status, data, size) != -1;
+}
+
+bool Channel::Error(const int receive_id, const int error) {
+    return MsgError(receive_id, error) != -1;
+}
+
+int Channel::ConnectSelf() {
+    return ConnectAttach(0, 0, impl_->attach->chid, _NTO_SIDE_CHANNEL, 0);
+}
+
+struct PulseTimer::Impl {
+    timer_t timer_id{};
+};
+
+PulseTimer::PulseTimer(const int connection_id, const int code,
+                       const std::chrono::milliseconds period)
+    : impl_(std::make_unique<Impl>()) {
+    sigevent event{};
+    SIGEV_PULSE_INIT(&event, connection_id, getprio(0), code, 0);
+
+    if (timer_create(CLOCK_MONOTONIC, &event, &impl_->timer_id) == -1) {
+        throw std::system_error(errno, std::system_category(),
+                                "Failed to create pulse timer");
+    }
+
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(period);
+    const auto nanoseconds =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(period - seconds);
+
+    itimerspec timer_spec{};
+    timer_spec.it_value.tv_sec = seconds.count();
+    timer_spec.it_value.tv_nsec = nanoseconds.count();
+    timer_spec.it_interval = timer_spec.it_value;
+
+    if (timer_settime(impl_->timer_id, 0, &timer_spec, nullptr) == -1) {
+        const int error = errno;
+        timer_delete(impl_->timer_id);
+        throw std::system_error(error, std::system_category(),
+                                "Failed to start pulse timer");
+    }
+}
+
+PulseTimer::~PulseTimer() {
+    if (impl_) {
+        timer_delete(impl_->timer_id);
+    }
+}
+
+PulseTimer::PulseTimer(PulseTimer&&) noexcept = default;
+PulseTimer& PulseTimer::operator=(PulseTimer&&) noexcept = default;
+
+int Connect(const std::string& name) {
+    return name_open(name.c_str(), 0);
+}
+
+void Disconnect(const int connection_id) {
+    ConnectDetach(connection_id);
+}
+
+int SendV(const int connection_id, const MessagePart* parts, const size_t part_count,
+          void* reply, const size_t reply_size) {
+    // Отброшенные части исказили бы сообщение, которое затем считалось бы отправленным
+    if (part_count > kMaxIov) {
+        errno = E2BIG;
+        return -1;
+    }
+
+    iov_t iov[kMaxIov];
+    size_t iov_count = 0;
+    for (size_t i = 0; i < part_count; ++i) {
+        SETIOV(&iov[iov_count], parts[i].data, parts[i].size);
+        ++iov_count;
+    }
+
+    iov_t reply_iov;
+    SETIOV(&reply_iov, reply, reply_size);
+    return MsgSendv(connection_id, iov, static_cast<int>(iov_count),
+                    &reply_iov, reply_size > 0 ? 1 : 0);
+}
+
+bool SendPulse(const int connection_id, const int priority, const int code,
+               const int value) {
+    return MsgSendPulse(connection_id, priority, code, value) != -1;
+}
+
+bool SendPulses(const int connection_id, const int priority, const int code,
+                const int value, const size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        if (!SendPulse(connection_id, priority, code, value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int CurrentPriority() {
+    return getprio(0);
+}
+
+int32_t CurrentThreadId() {
+    // На QNX pthread_t - номер потока в процессе, его же ядро передает в _msg_info::tid
+    return static_cast<int32_t>(pthread_self());
+}
+
+} // namespace nexus::ipc
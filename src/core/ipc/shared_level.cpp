@@ -0,0 +1,129 @@
+#include "shared_level.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <new>
+#include <system_error>
+
+namespace nexus::ipc {
+
+namespace {
+constexpr uint32_t kLevelMagic = 0x4E584C56; // "NXLV"
+constexpr uint32_t kLevelVersion = 1;
+
+// Права сегмента: клиенты того же пользователя или группы, не все процессы узла
+constexpr mode_t kSegmentMode = 0660;
+
+static_assert(std::atomic<uint8_t>::is_always_lock_free,
+              "Shared level requires address-free byte atomics");
+
+std::string MakeShmName(const std::string& name) {
+    return "/nexus_" + name + "_level";
+}
+} // namespace
+
+struct SharedLevel::Header {
+    std::atomic<uint32_t> magic;
+    uint32_t version;
+    std::atomic<uint8_t> threshold;
+};
+
+std::unique_ptr<SharedLevel> SharedLevel::Create(const std::string& name,
+                                                 const Severity severity) {
+    const std::string shm_name = MakeShmName(name);
+
+    // Сегмент предыдущего экземпляра сервиса переиспользуется: клиенты могут быть
+    // подключены к нему и не должны потерять порог
+    const int fd = shm_open(shm_name.c_str(), O_RDWR | O_CREAT, kSegmentMode);
+    if (fd == -1) {
+        throw std::system_error(errno, std::system_category(),
+                                "cannot create shared level: " + shm_name);
+    }
+    // Сегмент прежнего экземпляра мог быть создан с более широкими правами
+    fchmod(fd, kSegmentMode);
+
+    if (ftruncate(fd, static_cast<off_t>(sizeof(Header))) == -1) {
+        const int error = errno;
+        close(fd);
+        throw std::system_error(error, std::system_category(),
+                                "cannot resize shared level: " + shm_name);
+    }
+
+    void* base = mmap(nullptr, sizeof(Header), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int error = errno;
+    close(fd);
+    if (base == MAP_FAILED) {
+        throw std::system_error(error, std::system_category(),
+                                "cannot map shared level: " + shm_name);
+    }
+
+    auto* header = static_cast<Header*>(base);
+    if (header->magic.load(std::memory_order_acquire) != kLevelMagic
+        || header->version != kLevelVersion) {
+        header = new (base) Header{};
+        header->version = kLevelVersion;
+        header->threshold.store(severity, std::memory_order_relaxed);
+        header->magic.store(kLevelMagic, std::memory_order_release);
+    } else {
+        header->threshold.store(severity, std::memory_order_relaxed);
+    }
+
+    return std::unique_ptr<SharedLevel>(new SharedLevel(base, sizeof(Header)));
+}
+
+std::unique_ptr<SharedLevel> SharedLevel::Open(const std::string& name) {
+    const std::string shm_name = MakeShmName(name);
+
+    const int fd = shm_open(shm_name.c_str(), O_RDONLY, 0);
+    if (fd == -1) {
+        throw std::system_error(errno, std::system_category(),
+                                "cannot open shared level: " + shm_name);
+    }
+
+    struct stat info{};
+    if (fstat(fd, &info) == -1 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+        close(fd);
+        throw std::system_error(EINVAL, std::system_category(),
+                                "invalid shared level: " + shm_name);
+    }
+
+    void* base = mmap(nullptr, sizeof(Header), PROT_READ, MAP_SHARED, fd, 0);
+    const int error = errno;
+    close(fd);
+    if (base == MAP_FAILED) {
+        throw std::system_error(error, std::system_category(),
+                                "cannot map shared level: " + shm_name);
+    }
+
+    const auto* header = static_cast<const Header*>(base);
+    if (header->magic.load(std::memory_order_acquire) != kLevelMagic
+        || header->version != kLevelVersion) {
+        munmap(base, sizeof(Header));
+        throw std::system_error(EINVAL, std::system_category(),
+                                "invalid shared level: " + shm_name);
+    }
+
+    return std::unique_ptr<SharedLevel>(new SharedLevel(base, sizeof(Header)));
+}
+
+SharedLevel::SharedLevel(void* base, const size_t mapped_size)
+    : base_(base), mapped_size_(mapped_size), header_(static_cast<Header*>(base)) {
+}
+
+SharedLevel::~SharedLevel() {
+    munmap(base_, mapped_size_);
+}
+
+const std::atomic<uint8_t>& SharedLevel::Threshold() const noexcept {
+    return header_->threshold;
+}
+
+void SharedLevel::Set(const Severity severity) noexcept {
+    header_->threshold.store(severity, std::memory_order_relaxed);
+}
+
+} // namespace nexus::ipc
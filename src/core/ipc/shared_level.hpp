@@ -0,0 +1,72 @@
+#pragma once
+
+/**
+ * @file shared_level.hpp
+ * @brief Порог уровня логирования в разделяемой памяти
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Types
+#include "../../common/types/message_types.hpp"
+
+namespace nexus::ipc {
+
+/**
+ * @class SharedLevel
+ * @brief Порог уровня, который сервис публикует для всех клиентов сразу
+ *
+ * Сервис создает сегмент shm с одним атомарным байтом порога, клиенты отображают
+ * его и проверяют порог обычной загрузкой из своей памяти, без обращений к ядру.
+ * Изменение порога сервисом видно всем подключенным клиентам немедленно.
+ *
+ * Сегмент не удаляется при остановке сервиса: перезапущенный сервис открывает
+ * тот же сегмент, и клиенты продолжают видеть актуальный порог без переподключения.
+ */
+class SharedLevel {
+public:
+    /**
+     * @brief Создание или повторное открытие сегмента (сторона сервиса)
+     * @param name Имя сервиса, совпадающее с именем канала
+     * @param severity Начальный порог
+     * @throw std::system_error При ошибках shm_open/ftruncate/mmap
+     */
+    static std::unique_ptr<SharedLevel> Create(const std::string& name, Severity severity);
+
+    /**
+     * @brief Подключение к существующему сегменту (сторона клиента)
+     * @param name Имя сервиса, совпадающее с именем канала
+     * @throw std::system_error Если сегмент отсутствует или поврежден
+     */
+    static std::unique_ptr<SharedLevel> Open(const std::string& name);
+
+    ~SharedLevel();
+
+    SharedLevel(const SharedLevel&) = delete;
+    SharedLevel& operator=(const SharedLevel&) = delete;
+
+    /**
+     * @brief Атомарный порог в разделяемой памяти (действителен до разрушения объекта)
+     */
+    const std::atomic<uint8_t>& Threshold() const noexcept;
+
+    /**
+     * @brief Установка порога (сторона сервиса)
+     */
+    void Set(Severity severity) noexcept;
+
+private:
+    struct Header;
+
+    SharedLevel(void* base, size_t mapped_size);
+
+    void* const base_;
+    const size_t mapped_size_;
+    Header* const header_;
+};
+
+} // namespace nexus::ipc
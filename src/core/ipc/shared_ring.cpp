@@ -0,0 +1,281 @@
+#include "shared_ring.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <system_error>
+
+namespace nexus::ipc {
+
+namespace {
+constexpr uint32_t kRingMagic = 0x4E585247; // "NXRG"
+constexpr uint32_t kRingVersion = 3;
+constexpr size_t kCacheLineSize = 64;
+
+// Права сегмента: клиенты того же пользователя или группы, не все процессы узла
+constexpr mode_t kSegmentMode = 0660;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "Shared ring requires address-free 64-bit atomics");
+
+// Служебный заголовок слота, за ним следует текст записи
+struct SlotHeader {
+    std::atomic<uint64_t> sequence;
+    uint16_t length;
+    MessageCode code;
+    uint32_t pid;
+    uint32_t tid;
+    uint64_t timestamp;
+};
+
+// Наибольший размер слота, кратный строке кэша: длина записи в слоте - uint16_t
+constexpr size_t kMaxSlotSize = (UINT16_MAX + sizeof(SlotHeader)) & ~(kCacheLineSize - 1);
+
+std::string MakeShmName(const std::string& name) {
+    return "/nexus_" + name;
+}
+
+// Геометрия слотов, которой можно доверять при индексации отображения
+bool IsValidGeometry(const size_t slot_count, const size_t slot_size, const size_t mapped_size,
+                     const size_t header_size) {
+    return slot_count >= 2 && (slot_count & (slot_count - 1)) == 0
+           && slot_size >= sizeof(SlotHeader) && slot_size <= kMaxSlotSize
+           && slot_size % alignof(SlotHeader) == 0 && mapped_size >= header_size
+           && slot_count <= (mapped_size - header_size) / slot_size;
+}
+
+size_t RoundUpToPowerOfTwo(const size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+} // namespace
+
+struct SharedRing::Header {
+    std::atomic<uint32_t> magic;
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t slot_size;
+
+    alignas(kCacheLineSize) std::atomic<uint64_t> enqueue_position;
+    alignas(kCacheLineSize) std::atomic<uint64_t> dequeue_position;
+    alignas(kCacheLineSize) std::atomic<uint32_t> reader_waiting;
+};
+
+std::unique_ptr<SharedRing> SharedRing::Create(const std::string& name, size_t slot_count,
+                                               size_t slot_size) {
+    slot_count = RoundUpToPowerOfTwo(slot_count < 2 ? 2 : slot_count);
+    slot_size = std::min((std::max(slot_size, sizeof(SlotHeader) + 64) + kCacheLineSize - 1)
+                             & ~(kCacheLineSize - 1),
+                         kMaxSlotSize);
+    const size_t mapped_size = sizeof(Header) + slot_count * slot_size;
+    const std::string shm_name = MakeShmName(name);
+
+    // Сегмент мог остаться от аварийно завершенного экземпляра сервиса
+    shm_unlink(shm_name.c_str());
+
+    const int fd = shm_open(shm_name.c_str(), O_RDWR | O_CREAT | O_EXCL, kSegmentMode);
+    if (fd == -1) {
+        throw std::system_error(errno, std::system_category(),
+                                "cannot create shared ring: " + shm_name);
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(mapped_size)) == -1) {
+        const int error = errno;
+        close(fd);
+        shm_unlink(shm_name.c_str());
+        throw std::system_error(error, std::system_category(),
+                                "cannot resize shared ring: " + shm_name);
+    }
+
+    void* base = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int error = errno;
+    close(fd);
+    if (base == MAP_FAILED) {
+        shm_unlink(shm_name.c_str());
+        throw std::system_error(error, std::system_category(),
+                                "cannot map shared ring: " + shm_name);
+    }
+
+    auto* header = new (base) Header{};
+    header->version = kRingVersion;
+    header->slot_count = static_cast<uint32_t>(slot_count);
+    header->slot_size = static_cast<uint32_t>(slot_size);
+    header->enqueue_position.store(0, std::memory_order_relaxed);
+    header->dequeue_position.store(0, std::memory_order_relaxed);
+    // Читатель изначально ждет первого звонка
+    header->reader_waiting.store(1, std::memory_order_relaxed);
+
+    auto* slots = static_cast<char*>(base) + sizeof(Header);
+    for (size_t i = 0; i < slot_count; ++i) {
+        auto* slot = new (slots + i * slot_size) SlotHeader{};
+        slot->sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // Публикуем сегмент для клиентов только после полной инициализации
+    header->magic.store(kRingMagic, std::memory_order_release);
+
+    return std::unique_ptr<SharedRing>(
+        new SharedRing(shm_name, base, mapped_size, slot_count, slot_size, true));
+}
+
+std::unique_ptr<SharedRing> SharedRing::Open(const std::string& name) {
+    const std::string shm_name = MakeShmName(name);
+
+    const int fd = shm_open(shm_name.c_str(), O_RDWR, 0);
+    if (fd == -1) {
+        throw std::system_error(errno, std::system_category(),
+                                "cannot open shared ring: " + shm_name);
+    }
+
+    struct stat info{};
+    if (fstat(fd, &info) == -1 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+        close(fd);
+        throw std::system_error(EINVAL, std::system_category(),
+                                "invalid shared ring: " + shm_name);
+    }
+
+    const auto mapped_size = static_cast<size_t>(info.st_size);
+    void* base = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int error = errno;
+    close(fd);
+    if (base == MAP_FAILED) {
+        throw std::system_error(error, std::system_category(),
+                                "cannot map shared ring: " + shm_name);
+    }
+
+    // Геометрия читается из сегмента один раз: дальше используются проверенные копии
+    const auto* header = static_cast<const Header*>(base);
+    const bool valid = header->magic.load(std::memory_order_acquire) == kRingMagic;
+    const size_t slot_count = header->slot_count;
+    const size_t slot_size = header->slot_size;
+    if (!valid || header->version != kRingVersion
+        || !IsValidGeometry(slot_count, slot_size, mapped_size, sizeof(Header))) {
+        munmap(base, mapped_size);
+        throw std::system_error(EINVAL, std::system_category(),
+                                "invalid shared ring: " + shm_name);
+    }
+
+    return std::unique_ptr<SharedRing>(
+        new SharedRing(shm_name, base, mapped_size, slot_count, slot_size, false));
+}
+
+SharedRing::SharedRing(std::string shm_name, void* base, const size_t mapped_size,
+                       const size_t slot_count, const size_t slot_size, const bool owner)
+    : shm_name_(std::move(shm_name)), base_(base), mapped_size_(mapped_size),
+      slot_count_(slot_count), slot_size_(slot_size), slot_mask_(slot_count - 1), owner_(owner),
+      header_(static_cast<Header*>(base)) {
+}
+
+SharedRing::~SharedRing() {
+    munmap(base_, mapped_size_);
+    if (owner_) {
+        shm_unlink(shm_name_.c_str());
+    }
+}
+
+size_t SharedRing::MaxTextSize() const noexcept {
+    return slot_size_ - sizeof(SlotHeader);
+}
+
+char* SharedRing::SlotAt(const uint64_t position) const noexcept {
+    const uint64_t index = position & slot_mask_;
+    return static_cast<char*>(base_) + sizeof(Header) + index * slot_size_;
+}
+
+SharedRing::PushResult SharedRing::TryPush(const MessageCode code, const uint32_t pid,
+                                           const uint32_t tid, const uint64_t timestamp,
+                                           const char* text,
+                                           const size_t text_length) noexcept {
+    if (text_length > MaxTextSize()) {
+        return PushResult::TOO_LARGE;
+    }
+
+    // Резервирование слота
+    uint64_t position = header_->enqueue_position.load(std::memory_order_relaxed);
+    SlotHeader* slot = nullptr;
+    for (;;) {
+        slot = reinterpret_cast<SlotHeader*>(SlotAt(position));
+        const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<int64_t>(sequence - position);
+
+        if (difference == 0) {
+            if (header_->enqueue_position.compare_exchange_weak(
+                    position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            return PushResult::FULL;
+        } else {
+            position = header_->enqueue_position.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Заполнение и публикация
+    char* data = reinterpret_cast<char*>(slot) + sizeof(SlotHeader);
+    std::memcpy(data, text, text_length);
+    slot->code = code;
+    slot->pid = pid;
+    slot->tid = tid;
+    slot->timestamp = timestamp;
+    slot->length = static_cast<uint16_t>(text_length);
+    slot->sequence.store(position + 1, std::memory_order_seq_cst);
+
+    // Пара к PrepareWait: либо читатель увидит запись, либо мы увидим флаг ожидания.
+    // Пока читатель занят, флаг только читается, и строка кэша не переходит между ядрами
+    if (header_->reader_waiting.load(std::memory_order_seq_cst) != 0
+        && header_->reader_waiting.exchange(0, std::memory_order_seq_cst) != 0) {
+        return PushResult::PUSHED_WAKE;
+    }
+    return PushResult::PUSHED;
+}
+
+bool SharedRing::BeginRead(Record& record) noexcept {
+    const uint64_t position = header_->dequeue_position.load(std::memory_order_relaxed);
+    const auto* slot = reinterpret_cast<const SlotHeader*>(SlotAt(position));
+
+    if (slot->sequence.load(std::memory_order_acquire) != position + 1) {
+        return false;
+    }
+
+    record.code = slot->code;
+    record.pid = slot->pid;
+    record.tid = slot->tid;
+    record.timestamp = slot->timestamp;
+    record.text = reinterpret_cast<const char*>(slot) + sizeof(SlotHeader);
+    record.length = std::min<size_t>(slot->length, MaxTextSize());
+    return true;
+}
+
+void SharedRing::EndRead() noexcept {
+    const uint64_t position = header_->dequeue_position.load(std::memory_order_relaxed);
+    auto* slot = reinterpret_cast<SlotHeader*>(SlotAt(position));
+
+    slot->sequence.store(position + slot_count_, std::memory_order_release);
+    header_->dequeue_position.store(position + 1, std::memory_order_relaxed);
+}
+
+bool SharedRing::PrepareWait() noexcept {
+    header_->reader_waiting.store(1, std::memory_order_seq_cst);
+
+    const uint64_t position = header_->dequeue_position.load(std::memory_order_relaxed);
+    const auto* slot = reinterpret_cast<const SlotHeader*>(SlotAt(position));
+    if (slot->sequence.load(std::memory_order_seq_cst) == position + 1) {
+        // Запись появилась после опустошения - продолжаем чтение сами
+        header_->reader_waiting.store(0, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+} // namespace nexus::ipc
@@ -0,0 +1,140 @@
+#pragma once
+
+/**
+ * @file shared_ring.hpp
+ * @brief Кольцевой буфер записей в разделяемой памяти (много писателей, один читатель)
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Types
+#include "../../common/types/message_types.hpp"
+
+namespace nexus::ipc {
+
+/**
+ * @class SharedRing
+ * @brief Транспорт лог-записей через разделяемую память
+ *
+ * Сервис создает сегмент shm рядом со своим каналом name_attach, клиенты отображают
+ * его в свое адресное пространство и публикуют записи напрямую, без копирования через ядро.
+ * Буфер состоит из слотов фиксированного размера (алгоритм bounded MPMC queue Д. Вьюкова),
+ * читатель всегда один - поток сервиса.
+ *
+ * Для пробуждения читателя используется флаг ожидания в заголовке сегмента:
+ * писатель, обнаруживший ждущего читателя, должен отправить в канал сервиса
+ * пульс PULSE_RING_DOORBELL. Таким образом канал несет только "звонок" при переходе
+ * буфера из пустого состояния в непустое.
+ *
+ * Число и размер слотов проверяются при создании и подключении и дальше берутся
+ * из копий в объекте: процесс, испортивший заголовок сегмента, не заставит
+ * читателя обратиться за пределы отображения.
+ *
+ * @note Писатель, аварийно завершившийся между резервированием и публикацией слота,
+ *       блокирует чтение до перезапуска сервиса.
+ */
+class SharedRing {
+public:
+    /**
+     * @brief Результат публикации записи
+     */
+    enum class PushResult {
+        PUSHED,       ///< Запись опубликована
+        PUSHED_WAKE,  ///< Запись опубликована, читатель ждет - нужно отправить пульс
+        FULL,         ///< Свободных слотов нет
+        TOO_LARGE     ///< Запись не помещается в слот
+    };
+
+    /**
+     * @brief Представление прочитанной записи (действительно до EndRead)
+     */
+    struct Record {
+        MessageCode code;
+        uint32_t pid; ///< Процесс-автор записи
+        uint32_t tid; ///< Поток-автор записи
+        uint64_t timestamp; ///< Метка CaptureTicks() при вызове LOG_* (0 - не задана)
+        const char* text;
+        size_t length;
+    };
+
+    /**
+     * @brief Создание сегмента разделяемой памяти (сторона сервиса)
+     * @param name Имя сервиса, совпадающее с именем канала
+     * @param slot_count Число слотов (округляется вверх до степени двойки)
+     * @param slot_size Размер слота в байтах, включая служебный заголовок
+     *                  (не больше 64 КиБ: длина записи в слоте - uint16_t)
+     * @throw std::system_error При ошибках shm_open/ftruncate/mmap
+     */
+    static std::unique_ptr<SharedRing> Create(const std::string& name, size_t slot_count,
+                                              size_t slot_size);
+
+    /**
+     * @brief Подключение к существующему сегменту (сторона клиента)
+     * @param name Имя сервиса, совпадающее с именем канала
+     * @throw std::system_error Если сегмент отсутствует или поврежден
+     */
+    static std::unique_ptr<SharedRing> Open(const std::string& name);
+
+    ~SharedRing();
+
+    SharedRing(const SharedRing&) = delete;
+    SharedRing& operator=(const SharedRing&) = delete;
+
+    /**
+     * @brief Максимальная длина текста одной записи
+     */
+    size_t MaxTextSize() const noexcept;
+
+    /**
+     * @brief Публикация записи (потокобезопасно, из любого процесса)
+     * @param code Код сообщения
+     * @param pid Процесс-автор: по нему сервис находит имя клиента
+     * @param tid Поток-автор
+     * @param timestamp Метка CaptureTicks() при вызове LOG_*
+     * @param text Текст сообщения
+     * @param text_length Длина текста
+     */
+    PushResult TryPush(MessageCode code, uint32_t pid, uint32_t tid, uint64_t timestamp,
+                       const char* text, size_t text_length) noexcept;
+
+    /**
+     * @brief Получение самой старой записи (только поток сервиса)
+     * @param record [out] Представление записи
+     * @return false, если опубликованных записей нет
+     */
+    bool BeginRead(Record& record) noexcept;
+
+    /**
+     * @brief Освобождение слота, полученного через BeginRead
+     */
+    void EndRead() noexcept;
+
+    /**
+     * @brief Переход читателя в ожидание
+     * @return true, если буфер пуст и следующая запись вызовет пульс;
+     *         false, если данные появились и чтение нужно продолжить
+     */
+    bool PrepareWait() noexcept;
+
+private:
+    struct Header;
+
+    SharedRing(std::string shm_name, void* base, size_t mapped_size, size_t slot_count,
+               size_t slot_size, bool owner);
+
+    char* SlotAt(uint64_t position) const noexcept;
+
+    const std::string shm_name_;
+    void* const base_;
+    const size_t mapped_size_;
+    const size_t slot_count_;
+    const size_t slot_size_;
+    const uint64_t slot_mask_;
+    const bool owner_;
+    Header* const header_;
+};
+
+} // namespace nexus::ipc
@@ -0,0 +1,198 @@
+#pragma once
+
+/**
+ * @file transport.hpp
+ * @brief Переносимый транспорт сообщений: именованные каналы, пульсы и синхронный ответ
+ *
+ * Интерфейс повторяет модель QNX (name_attach/MsgReceive/MsgRead/MsgReply/MsgError/MsgSend/
+ * MsgSendPulse).
+ * Реализация выбирается при сборке: qnx_transport.cpp вызывает примитивы ядра QNX
+ * напрямую, linux_transport.cpp эмулирует их поверх сокетов AF_UNIX SOCK_SEQPACKET.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Types
+#include "../../common/types/pulse_types.hpp"
+
+namespace nexus::ipc {
+
+// Фрагмент сообщения для отправки без склейки
+struct MessagePart {
+    const void* data;
+    size_t size;
+};
+
+/**
+ * @brief Сведения об отправителе принятого сообщения
+ */
+struct ReceiveInfo {
+    /// @brief Число байт сообщения, помещенных в буфер приема
+    size_t length{0};
+
+    /// @brief Процесс отправителя (0, если неизвестен)
+    int32_t pid{0};
+
+    /// @brief Поток отправителя, как его возвращает CurrentThreadId() (0, если неизвестен)
+    int32_t tid{0};
+
+    /// @brief Идентификатор соединения отправителя на стороне сервера
+    int32_t scoid{0};
+};
+
+/**
+ * @class Channel
+ * @brief Именованный канал сервера
+ *
+ * Receive() можно вызывать одновременно из нескольких потоков: каждое сообщение
+ * и каждый пульс получает ровно один из них.
+ */
+class Channel {
+public:
+    /**
+     * @brief Регистрация канала под именем
+     * @param name Имя, по которому клиенты подключаются через Connect()
+     * @throw std::system_error При ошибках регистрации имени
+     */
+    static std::unique_ptr<Channel> Attach(const std::string& name);
+
+    ~Channel();
+
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+
+    /**
+     * @brief Ожидание сообщения или пульса
+     * @param buffer Буфер приема, не меньше 64 байт
+     * @param size Размер буфера; не поместившуюся часть сообщения можно дочитать Read()
+     * @param info [out] Сведения об отправителе сообщения (для пульса не заполняются)
+     * @return Идентификатор для Reply() (> 0); 0 - принят пульс, в начале буфера
+     *         лежит Pulse; -1 - ошибка, код в errno (EINTR - прервано сигналом)
+     */
+    int Receive(void* buffer, size_t size, ReceiveInfo& info);
+
+    /**
+     * @brief Чтение части принятого сообщения, не поместившейся в буфер Receive()
+     * @param receive_id Идентификатор, полученный от Receive()
+     * @param buffer Буфер для данных
+     * @param size Размер буфера
+     * @param offset Смещение от начала сообщения
+     * @return Число прочитанных байт (0 - данных после offset нет) или -1, код в errno
+     *
+     * Доступно до ответа отправителю. На Linux сообщение, принятое Receive(),
+     * хранится в потоке приема, поэтому Read() вызывается из того же потока.
+     */
+    int Read(int receive_id, void* buffer, size_t size, size_t offset);
+
+    /**
+     * @brief Ответ отправителю, разблокирующий его Send()
+     * @param receive_id Идентификатор, полученный от Receive()
+     * @param status Статус, который вернет Send() у клиента
+     * @param data Данные ответа (могут отсутствовать)
+     * @param size Размер данных ответа
+     * @return false при ошибке, код в errno
+     */
+    bool Reply(int receive_id, int status, const void* data = nullptr, size_t size = 0);
+
+    /**
+     * @brief Ответ отправителю ошибкой: его Send() вернет -1 с кодом error в errno
+     * @return false при ошибке, код в errno
+     */
+    bool Error(int receive_id, int error);
+
+    /**
+     * @brief Соединение с собственным каналом для пульсов пробуждения и таймеров
+     * @return Идентификатор соединения или -1, код в errno
+     */
+    int ConnectSelf();
+
+private:
+    struct Impl;
+
+    explicit Channel(std::unique_ptr<Impl> impl);
+
+    std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * @class PulseTimer
+ * @brief Периодический пульс в заданное соединение
+ *
+ * Таймер останавливается при разрушении объекта.
+ */
+class PulseTimer {
+public:
+    /**
+     * @brief Запуск таймера
+     * @param connection_id Соединение, в которое отправляется пульс
+     * @param code Код пульса
+     * @param period Период срабатывания
+     * @throw std::system_error При ошибках создания таймера
+     */
+    PulseTimer(int connection_id, int code, std::chrono::milliseconds period);
+
+    ~PulseTimer();
+
+    PulseTimer(PulseTimer&&) noexcept;
+    PulseTimer& operator=(PulseTimer&&) noexcept;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * @brief Подключение к именованному каналу
+ * @return Идентификатор соединения или -1, код в errno
+ */
+int Connect(const std::string& name);
+
+/**
+ * @brief Закрытие соединения
+ */
+void Disconnect(int connection_id);
+
+/**
+ * @brief Синхронная отправка сообщения из нескольких частей с ожиданием ответа
+ * @param connection_id Соединение с каналом
+ * @param parts Части сообщения, передаваются без склейки
+ * @param part_count Число частей
+ * @param reply Буфер ответа (может отсутствовать)
+ * @param reply_size Размер буфера ответа; лишние данные ответа отбрасываются
+ * @return Статус ответа сервера или -1, код в errno
+ *         (E2BIG на QNX, если частей больше 16 - предела одного MsgSendv)
+ */
+int SendV(int connection_id, const MessagePart* parts, size_t part_count,
+          void* reply = nullptr, size_t reply_size = 0);
+
+/**
+ * @brief Отправка пульса без ожидания ответа
+ * @return false при ошибке, код в errno
+ */
+bool SendPulse(int connection_id, int priority, int code, int value = 0);
+
+/**
+ * @brief Отправка нескольких одинаковых пульсов
+ *
+ * На Linux пульсы уходят одним системным вызовом sendmmsg.
+ *
+ * @return false при ошибке, код в errno
+ */
+bool SendPulses(int connection_id, int priority, int code, int value, size_t count);
+
+/**
+ * @brief Приоритет текущего потока для отправки пульсов
+ */
+int CurrentPriority();
+
+/**
+ * @brief Идентификатор текущего потока, который сервер получает в ReceiveInfo::tid
+ */
+int32_t CurrentThreadId();
+
+} // namespace nexus::ipc
@@ -1,54 +1,548 @@
 #include "base_logger.hpp"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
 namespace nexus::logger {
 
 using namespace std::literals;
 
+namespace {
+// Начальная емкость буфера строки: типичное сообщение плюс время и уровень,
+// более длинные строки увеличивают буфер
+constexpr size_t kLineBufferCapacity = 8192;
+
+// Буфер строки лога, переиспользуемый всеми сообщениями потока
+std::string& LineBuffer() {
+    thread_local std::string buffer = [] {
+        std::string line;
+        line.reserve(kLineBufferCapacity);
+        return line;
+    }();
+    return buffer;
+}
+
+// Число записей, забираемых потоком записи из очереди за один раз
+constexpr size_t kWriterBatchSize = 64;
+} // namespace
+
 BaseLogger::BaseLogger(const std::string& name)
     : BaseQnxService(name) {
 }
 
+BaseLogger::~BaseLogger() {
+    StopWriter();
+}
+
 void BaseLogger::Run() {
-    Write("Logger has been started."s);
-    Flush();
-    BaseQnxService::Run();
-    Write("Logger has been stopped."s);
-    Flush();
+    if (writer_.joinable()) {
+        throw std::runtime_error("Logger is already running");
+    }
+
+    if (flush_policy_.max_delay.count() > 0) {
+        // Проверяем вдвое чаще порога, чтобы задержка сброса не превышала 1.5 * max_delay
+        StartPulseTimer(ipc::PULSE_FLUSH_TIMER,
+                        std::max(flush_policy_.max_delay / 2, std::chrono::milliseconds{1}));
+    }
+
+    if (stats_interval_.count() > 0) {
+        StartPulseTimer(ipc::PULSE_STATS_TIMER, stats_interval_);
+    }
+
+    if (overload_policy_ != OverloadPolicy::BLOCK && drop_report_interval_.count() > 0) {
+        StartPulseTimer(ipc::PULSE_DROP_REPORT, drop_report_interval_);
+    }
+
+    if (repeat_interval_.count() > 0) {
+        StartPulseTimer(ipc::PULSE_REPEAT_TIMER, repeat_interval_);
+    }
+
+    stats_.Start();
+    queue_ = std::make_unique<RecordQueue>(queue_capacity_, overload_policy_);
+    writer_ = std::thread(&BaseLogger::WriterLoop, this);
+
+    PushRaw("Logger has been started."sv);
+    try {
+        shared_level_ = ipc::SharedLevel::Create(GetServerName(), log_level_);
+    } catch (const std::exception& e) {
+        std::string& line = LineBuffer();
+        line.assign("Shared log level is unavailable: "sv);
+        line.append(e.what());
+        PushRaw(line);
+    }
+
+    try {
+        BaseQnxService::Run();
+    } catch (...) {
+        StopWriter();
+        throw;
+    }
+    DrainSharedRing();
+    ReportDropped();
+    if (repeat_interval_.count() > 0) {
+        queue_->Push(RecordKind::REPEATS, ipc::LOG_INFO, {}, {});
+    }
+    PushRaw("Logger has been stopped."sv);
+
+    // Поток записи дописывает все, что осталось в очереди
+    StopWriter();
+}
+
+void BaseLogger::EnableSharedRing(const size_t slot_count, const size_t slot_size) {
+    shared_ring_ = ipc::SharedRing::Create(GetServerName(), slot_count, slot_size);
 }
 
-void BaseLogger::HandlePulse(const _pulse& ipc_pulse) {
+void BaseLogger::SetTimestampFormat(const utils::time::TimestampClock clock,
+                                    const utils::time::TimestampPrecision precision) {
+    timestamp_formatter_ = utils::time::TimestampFormatter(clock, precision);
+}
+
+void BaseLogger::SetFlushPolicy(const FlushPolicy& policy) {
+    flush_policy_ = policy;
+}
+
+void BaseLogger::SetQueueCapacity(const size_t capacity) {
+    queue_capacity_ = capacity;
+}
+
+void BaseLogger::SetLogLevel(const ipc::Severity severity) {
+    log_level_ = severity;
+}
+
+void BaseLogger::SetOverloadPolicy(const OverloadPolicy policy,
+                                   const std::chrono::milliseconds report_interval) {
+    overload_policy_ = policy;
+    drop_report_interval_ = report_interval;
+}
+
+void BaseLogger::SetShowSenderIds(const bool show) {
+    show_sender_ids_ = show;
+}
+
+void BaseLogger::SetStatsInterval(const std::chrono::milliseconds period) {
+    stats_interval_ = period;
+}
+
+void BaseLogger::SetRepeatSuppression(const std::chrono::milliseconds summary_interval) {
+    repeat_interval_ = summary_interval;
+}
+
+void BaseLogger::HandlePulse(const ipc::Pulse& ipc_pulse) {
+    const RecordQueue::Turn turn(*queue_, CurrentReceiveSequence());
+    LoggerStats::Add(stats_.Local().pulses_received);
+
+    if (ipc_pulse.code == ipc::PULSE_RING_DOORBELL) {
+        DrainSharedRing();
+        return;
+    }
+
+    if (ipc_pulse.code == ipc::PULSE_FLUSH_TIMER) {
+        queue_->Push(RecordKind::FLUSH, ipc::LOG_INFO, {}, {});
+        return;
+    }
+
+    if (ipc_pulse.code == ipc::PULSE_DROP_REPORT) {
+        ReportDropped();
+        return;
+    }
+
+    if (ipc_pulse.code == ipc::PULSE_REPEAT_TIMER) {
+        queue_->Push(RecordKind::REPEATS, ipc::LOG_INFO, {}, {});
+        return;
+    }
+
+    if (ipc_pulse.code == ipc::PULSE_STATS_TIMER) {
+        const ipc::LoggerStatsSnapshot snapshot = CollectStats();
+        PushRaw(LoggerStats::Format(snapshot, &last_stats_));
+        last_stats_ = snapshot;
+        return;
+    }
+
+    if (ipc_pulse.code == ipc::PULSE_SET_LEVEL) {
+        const int value = ipc_pulse.value;
+        if (value < ipc::SEVERITY_TRACE || value > ipc::SEVERITY_OFF) {
+            return;
+        }
+
+        log_level_ = static_cast<ipc::Severity>(value);
+        if (shared_level_) {
+            shared_level_->Set(log_level_);
+        }
+
+        std::string& line = LineBuffer();
+        line.assign("Log level set to "sv);
+        line.append(GetLevelName(log_level_));
+        PushRaw(line);
+        return;
+    }
+
     if (ipc_pulse.code == ipc::PULSE_SHUTDOWN) {
-        Write("Received shutdown pulse - stopping..."s);
-        Flush();
+        PushRaw("Received shutdown pulse - stopping..."sv);
         Stop();
     }
 }
 
-void BaseLogger::HandleMessage([[maybe_unused]] int receive_id,
-                               const ipc::IpcMessage& ipc_message) {
+void BaseLogger::HandleMessage(const int receive_id, const ipc::ReceiveInfo& info,
+                               const ipc::MessageHeader& header, const std::string_view payload) {
+    const uint64_t received = utils::time::ToNanoseconds(utils::time::GetMonotonicTime());
+    LoggerStats::ThreadCounters& counters = stats_.Local();
 
-    using namespace utils;
-    std::string message_time = time::ToString(time::GetCurrentTime());
-    std::string message_header = GetMessageHeader(ipc_message.code);
-    std::string message_text(ipc_message.text, sizeof(ipc_message.text));
+    {
+        const RecordQueue::Turn turn(*queue_, CurrentReceiveSequence());
 
-    Write(message_time + message_header + message_text);
-    Flush();
+        if (header.code == ipc::STATS_QUERY) {
+            // Статус ответа - размер снимка, чтобы клиент мог проверить версию протокола
+            const ipc::LoggerStatsSnapshot snapshot = CollectStats();
+            ReplyMessage(receive_id, static_cast<int>(sizeof(snapshot)), &snapshot,
+                         sizeof(snapshot));
+            return;
+        }
+
+        DrainSharedRing();
+        QueueMessage(header, payload,
+                     {static_cast<uint32_t>(info.pid), static_cast<uint32_t>(info.tid)},
+                     counters);
+    }
+
+    // Клиент заблокирован в Send() от приема до ответа, который следует сразу за возвратом
+    LoggerStats::Add(counters.bytes_received, sizeof(header) + payload.size());
+    LoggerStats::Record(counters.reply_latency,
+                        utils::time::ToNanoseconds(utils::time::GetMonotonicTime()) - received);
+}
+
+void BaseLogger::QueueMessage(const ipc::MessageHeader& header, const std::string_view payload,
+                              const Sender& sender, LoggerStats::ThreadCounters& counters) {
+    const ipc::MessageCode code = header.code;
+    const timespec time = RecordTime(header.timestamp, timestamp_formatter_.Now());
+
+    if (code == ipc::LOG_BATCH) {
+        LoggerStats::Add(counters.batches_received);
+        LoggerStats::Add(counters.messages_received, HandleBatch(payload, time, sender.pid));
+        return;
+    }
+
+    // Двоичные данные регистрации формата передаются потоку записи как есть
+    if (code == ipc::LOG_FORMAT) {
+        queue_->Push(RecordKind::FORMAT, code, time, payload);
+        return;
+    }
+
+    // Имя клиента запоминает поток записи, до него же доходят записи клиента
+    if (code == ipc::LOG_REGISTER) {
+        queue_->Push(RecordKind::CLIENT, code, time, payload, sender);
+        return;
+    }
+
+    LoggerStats::Add(counters.messages_received);
+    queue_->Push(RecordKind::MESSAGE, code, time, payload, sender);
+}
+
+size_t BaseLogger::HandleBatch(const std::string_view payload, const timespec& time,
+                               const uint32_t pid) {
+    if (payload.size() < sizeof(ipc::BatchHeader)) {
+        return 0;
+    }
+
+    ipc::BatchHeader batch_header{};
+    std::memcpy(&batch_header, payload.data(), sizeof(batch_header));
+
+    size_t offset = sizeof(batch_header);
+    uint16_t i = 0;
+    for (; i < batch_header.record_count; ++i) {
+        if (offset + sizeof(ipc::RecordHeader) > payload.size()) {
+            break;
+        }
+
+        ipc::RecordHeader record_header{};
+        std::memcpy(&record_header, payload.data() + offset, sizeof(record_header));
+        offset += sizeof(record_header);
+
+        const size_t length = std::min<size_t>(record_header.length, payload.size() - offset);
+        queue_->Push(RecordKind::MESSAGE, record_header.code,
+                     RecordTime(record_header.timestamp, time), payload.substr(offset, length),
+                     {pid, record_header.thread_id});
+        offset += length;
+    }
+    return i;
+}
+
+timespec BaseLogger::RecordTime(const uint64_t timestamp,
+                                const timespec& received) const noexcept {
+    return timestamp != 0 ? timestamp_formatter_.FromCapture(capture_calibration_, timestamp)
+                          : received;
+}
+
+void BaseLogger::DrainSharedRing() {
+    if (!shared_ring_) {
+        return;
+    }
+
+    const timespec time = timestamp_formatter_.Now();
+    LoggerStats::ThreadCounters& counters = stats_.Local();
+    do {
+        ipc::SharedRing::Record record{};
+        while (shared_ring_->BeginRead(record)) {
+            queue_->Push(RecordKind::MESSAGE, record.code, RecordTime(record.timestamp, time),
+                         {record.text, record.length}, {record.pid, record.tid});
+            LoggerStats::Add(counters.messages_received);
+            LoggerStats::Add(counters.bytes_received, record.length);
+            shared_ring_->EndRead();
+        }
+        // Повторяем, если запись появилась между опустошением и уходом в ожидание
+    } while (!shared_ring_->PrepareWait());
 }
 
 void BaseLogger::HandleReceiveError(const int error_code) {
-    Write("Receive error: "s + std::string(strerror(error_code)));
+    const RecordQueue::Turn turn(*queue_, CurrentReceiveSequence());
+    LoggerStats::Add(stats_.Local().receive_errors);
+
+    std::string& line = LineBuffer();
+    line.assign("Receive error: "sv);
+    line.append(strerror(error_code));
+    PushRaw(line);
+}
+
+void BaseLogger::ReportDropped() {
+    const uint64_t dropped = queue_->TakeDropped();
+    if (dropped == 0) {
+        return;
+    }
+
+    std::string& line = LineBuffer();
+    line.assign(std::to_string(dropped));
+    line.append(" messages dropped (logger queue full)"sv);
+    PushRaw(line);
+}
+
+void BaseLogger::PushRaw(const std::string_view text) {
+    queue_->Push(RecordKind::RAW, ipc::LOG_INFO, {}, text);
+}
+
+void BaseLogger::WriterLoop() {
+    std::vector<LogRecord> records(kWriterBatchSize);
+    char time_buffer[utils::time::kTimeStringSize];
+    writer_stats_ = &stats_.Local();
+
+    while (const size_t count = queue_->PopBatch(records)) {
+        for (size_t i = 0; i < count; ++i) {
+            const LogRecord& record = records[i];
+            switch (record.kind) {
+                case RecordKind::MESSAGE: {
+                    if (repeat_interval_.count() > 0 && SuppressRepeat(record)) {
+                        break;
+                    }
+                    const size_t time_length = timestamp_formatter_.Format(record.time,
+                                                                           time_buffer);
+                    ipc::MessageCode level = record.code;
+                    std::string_view text = record.text;
+                    if (record.code == ipc::LOG_FORMATTED) {
+                        text = format_decoder_.Decode(record.text, level);
+                    }
+                    WriteLine(level, FormatLine({time_buffer, time_length}, level,
+                                                sender_cache_.Name(record.sender.pid),
+                                                show_sender_ids_ ? &record.sender : nullptr,
+                                                text));
+                    break;
+                }
+                case RecordKind::RAW:
+                    Write(record.text);
+                    FlushPending();
+                    break;
+                case RecordKind::FLUSH:
+                    HandleFlushTimer();
+                    break;
+                case RecordKind::FORMAT:
+                    format_decoder_.Register(record.text);
+                    break;
+                case RecordKind::CLIENT:
+                    sender_cache_.Register(record.sender.pid, record.text);
+                    break;
+                case RecordKind::REPEATS:
+                    duplicate_filter_.TakeSummaries(repeat_summaries_);
+                    for (const RepeatSummary& summary : repeat_summaries_) {
+                        WriteRepeatSummary(summary);
+                    }
+                    break;
+            }
+        }
+
+        // Не более одного сброса на пачку записей
+        CommitPending();
+    }
+
+    OnWriterStopped();
+}
+
+bool BaseLogger::SuppressRepeat(const LogRecord& record) {
+    RepeatSummary summary{};
+    if (duplicate_filter_.Check(record.sender, ipc::LevelOfRecord(record.code, record.text),
+                                record.text, record.time, summary)) {
+        return true;
+    }
+
+    if (summary.count > 0) {
+        WriteRepeatSummary(summary);
+    }
+    return false;
+}
+
+void BaseLogger::WriteRepeatSummary(const RepeatSummary& summary) {
+    char time_buffer[utils::time::kTimeStringSize];
+    const size_t time_length = timestamp_formatter_.Format(summary.time, time_buffer);
+
+    char text[64];
+    const int length = snprintf(text, sizeof(text), "last message repeated %llu times",
+                                static_cast<unsigned long long>(summary.count));
+    WriteLine(summary.level,
+              FormatLine({time_buffer, time_length}, summary.level,
+                         sender_cache_.Name(summary.sender.pid),
+                         show_sender_ids_ ? &summary.sender : nullptr,
+                         {text, static_cast<size_t>(std::max(length, 0))}));
+}
+
+void BaseLogger::WriteMessage(const ipc::MessageCode level,
+                              const std::string_view formatted_message) {
+    (void)level;
+    Write(formatted_message);
+}
+
+void BaseLogger::OnWriterStopped() {
+}
+
+void BaseLogger::StopWriter() {
+    if (!writer_.joinable()) {
+        return;
+    }
+
+    queue_->Close();
+    writer_.join();
+}
+
+std::string_view BaseLogger::FormatLine(const std::string_view message_time,
+                                        const ipc::MessageCode code,
+                                        const std::string_view sender_name,
+                                        const Sender* sender_ids,
+                                        const std::string_view message_text) {
+    std::string& line = LineBuffer();
+    line.clear();
+    line.append(message_time);
+    line.append(GetMessageHeader(code));
+    line.append(sender_name);
+    if (sender_ids != nullptr) {
+        char ids[32];
+        const int length = snprintf(ids, sizeof(ids), "[%u:%u]", sender_ids->pid, sender_ids->tid);
+        line.append(ids, static_cast<size_t>(std::max(length, 0)));
+    }
+    line.push_back(' ');
+    line.append(message_text);
+    return line;
+}
+
+void BaseLogger::WriteLine(const ipc::MessageCode code, const std::string_view line) {
+    const timespec begin = utils::time::GetMonotonicTime();
+    WriteMessage(code, line);
+    const timespec end = utils::time::GetMonotonicTime();
+
+    LoggerStats::Add(writer_stats_->records_written);
+    LoggerStats::Add(writer_stats_->bytes_written, line.size() + 1);
+    LoggerStats::Record(writer_stats_->write_latency,
+                        utils::time::ToNanoseconds(end) - utils::time::ToNanoseconds(begin));
+
+    if (pending_messages_ == 0) {
+        first_pending_time_ = utils::time::GetMonotonicTime();
+    }
+    ++pending_messages_;
+    pending_bytes_ += line.size() + 1;
+
+    if ((flush_policy_.max_messages > 0 && pending_messages_ >= flush_policy_.max_messages)
+        || (flush_policy_.max_bytes > 0 && pending_bytes_ >= flush_policy_.max_bytes)
+        || (flush_policy_.flush_on_error && ipc::SeverityOf(code) >= ipc::SEVERITY_ERROR)) {
+        flush_due_ = true;
+    }
+}
+
+void BaseLogger::CommitPending() {
+    if (flush_due_) {
+        FlushPending();
+    }
+}
+
+void BaseLogger::FlushPending() {
+    const timespec begin = utils::time::GetMonotonicTime();
     Flush();
+    const timespec end = utils::time::GetMonotonicTime();
+
+    LoggerStats::Add(writer_stats_->flushes);
+    LoggerStats::Record(writer_stats_->flush_latency,
+                        utils::time::ToNanoseconds(end) - utils::time::ToNanoseconds(begin));
+    pending_messages_ = 0;
+    pending_bytes_ = 0;
+    flush_due_ = false;
 }
 
-std::string BaseLogger::GetMessageHeader(const ipc::MessageCode& code) {
+void BaseLogger::HandleFlushTimer() {
+    if (pending_messages_ == 0) {
+        return;
+    }
+
+    const auto waited = utils::time::TimeDifference(first_pending_time_,
+                                                    utils::time::GetMonotonicTime());
+    if (utils::time::ToMilliseconds(waited) >= flush_policy_.max_delay.count()) {
+        FlushPending();
+    }
+}
+
+ipc::LoggerStatsSnapshot BaseLogger::CollectStats() {
+    ipc::LoggerStatsSnapshot snapshot = stats_.Snapshot();
+
+    size_t depth = 0;
+    size_t max_depth = 0;
+    const size_t capacity = queue_->Depth(depth, max_depth);
+    snapshot.queue_depth = static_cast<uint32_t>(depth);
+    snapshot.queue_depth_max = static_cast<uint32_t>(max_depth);
+    snapshot.queue_capacity = static_cast<uint32_t>(capacity);
+    snapshot.messages_dropped = queue_->Dropped();
+    return snapshot;
+}
+
+std::string_view BaseLogger::GetMessageHeader(const ipc::MessageCode& code) {
     switch (code) {
+        case ipc::LOG_TRACE:
+            return " [TRACE] "sv;
+        case ipc::LOG_DEBUG:
+            return " [DEBUG] "sv;
         case ipc::LOG_INFO:
-            return " [INFO] "s;
+            return " [INFO] "sv;
+        case ipc::LOG_WARN:
+            return " [WARN] "sv;
         case ipc::LOG_ERROR:
-            return " [ERROR] "s;
+            return " [ERROR] "sv;
+        case ipc::LOG_FATAL:
+            return " [FATAL] "sv;
+        default:
+            return " [UNKNOWN] "sv;
+    }
+}
+
+std::string_view BaseLogger::GetLevelName(const ipc::Severity severity) {
+    switch (severity) {
+        case ipc::SEVERITY_TRACE:
+            return "TRACE"sv;
+        case ipc::SEVERITY_DEBUG:
+            return "DEBUG"sv;
+        case ipc::SEVERITY_INFO:
+            return "INFO"sv;
+        case ipc::SEVERITY_WARN:
+            return "WARN"sv;
+        case ipc::SEVERITY_ERROR:
+            return "ERROR"sv;
+        case ipc::SEVERITY_FATAL:
+            return "FATAL"sv;
         default:
-            return " [UNKNOWN] "s;
+            return "OFF"sv;
     }
 }
 
@@ -5,15 +5,35 @@
  * @brief Базовый класс системы логирования с IPC
  */
 
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+
 // Base
 #include "../ipc/base_qnx_service.hpp"
+#include "../ipc/shared_level.hpp"
+#include "../ipc/shared_ring.hpp"
+
+// Logger
+#include "duplicate_filter.hpp"
+#include "flush_policy.hpp"
+#include "format_decoder.hpp"
+#include "logger_stats.hpp"
+#include "overload_policy.hpp"
+#include "record_queue.hpp"
+#include "sender_cache.hpp"
 
 // Utils
+#include "../../common/utils/capture_clock.hpp"
 #include "../../common/utils/time_utils.hpp"
+#include "../../common/utils/timestamp_formatter.hpp"
 
 // Types
+#include "../../common/types/format_types.hpp"
 #include "../../common/types/message_types.hpp"
 #include "../../common/types/pulse_types.hpp"
+#include "../../common/types/stats_types.hpp"
 
 namespace nexus::logger {
 /**
@@ -24,6 +44,27 @@ namespace nexus::logger {
  * обработку сообщений. Предоставляет интерфейс для различных бэкендов логирования
  * (файл, консоль, сеть и т.д.) через чисто виртуальные методы Write() и Flush().
  *
+ * Записи LOG_FORMATTED (макросы LOG_*_FMT) принимаются в двоичном виде и
+ * ставятся в очередь без разбора; текст по зарегистрированному формату
+ * собирается в потоке записи.
+ *
+ * Прием и запись разделены: поток Run() только копирует запись во внутреннюю
+ * ограниченную очередь и сразу отвечает клиенту, а отдельный поток записи
+ * форматирует записи и вызывает Write()/Flush(). Задержка клиента таким образом
+ * не зависит от скорости приемника.
+ *
+ * При нескольких потоках приема (SetReceiveThreads()) записи попадают в очередь
+ * в порядке глобальных номеров приема, поэтому вывод сохраняет полный порядок
+ * приема и, как следствие, порядок сообщений каждого отправителя.
+ *
+ * Подряд идущие одинаковые записи отправителя могут сворачиваться в одну
+ * строку и сводку "last message repeated N times" (SetRepeatSuppression()).
+ *
+ * Логгер ведет собственные метрики (LoggerStats): объем приема и записи, ошибки
+ * приема, глубину очереди и гистограммы задержек ответа, Write() и Flush().
+ * Снимок возвращается в ответе на сообщение STATS_QUERY и может периодически
+ * выводиться в приемник (SetStatsInterval()).
+ *
  * @note Паттерн: Template Method - базовый класс определяет структуру обработки
  *       сообщений, наследники реализуют конкретные механизмы записи.
  */
@@ -38,33 +79,142 @@ public:
     explicit BaseLogger(const std::string& name);
 
     /**
-     * @brief Деструктор по умолчанию
+     * @brief Деструктор
      * @note Виртуальный для корректного удаления наследников
      */
-    ~BaseLogger() override = default;
+    ~BaseLogger() override;
 
     /**
      * @brief Запуск цикла обработки лог-сообщений
      *
      * Переопределяет базовый метод для добавления специфичной для логирования
-     * инициализации и обработки. Блокирует выполнение до остановки сервиса.
+     * инициализации и обработки. Запускает поток записи, блокирует выполнение
+     * до остановки сервиса и дожидается записи всех принятых сообщений.
      *
      * @throw std::system_error При ошибках IPC
      * @throw std::runtime_error При попытке повторного запуска
      */
     void Run();
 
+    /**
+     * @brief Включение транспорта через разделяемую память
+     * @param slot_count Число слотов кольцевого буфера
+     * @param slot_size Размер слота в байтах (ограничивает длину записи)
+     *
+     * Создает сегмент shm с именем сервиса. Клиенты в режиме DeliveryMode::SHARED_MEMORY
+     * публикуют записи прямо в него, а канал используется только для пульса-звонка.
+     *
+     * @throw std::system_error При ошибках создания сегмента
+     * @note Должен вызываться до Run()
+     */
+    void EnableSharedRing(size_t slot_count = 4096, size_t slot_size = 512);
+
+    /**
+     * @brief Настройка формата временных меток
+     * @param clock Местное время, UTC или монотонные секунды
+     * @param precision Миллисекунды или микросекунды
+     *
+     * @note Должен вызываться до Run()
+     */
+    void SetTimestampFormat(utils::time::TimestampClock clock,
+                            utils::time::TimestampPrecision precision);
+
+    /**
+     * @brief Настройка политики группового сброса
+     * @param policy Пороги по числу сообщений, байтам и времени
+     *
+     * При ненулевом max_delay запускается таймерный пульс PULSE_FLUSH_TIMER,
+     * сбрасывающий данные, которые ждут дольше заданного времени.
+     *
+     * @note Должен вызываться до Run()
+     */
+    void SetFlushPolicy(const FlushPolicy& policy);
+
+    /**
+     * @brief Настройка емкости очереди между приемом и записью
+     * @param capacity Максимальное число записей в очереди
+     *
+     * Поведение при заполненной очереди задает SetOverloadPolicy(), по умолчанию
+     * поток приема блокируется до освобождения места.
+     *
+     * @note Должен вызываться до Run()
+     */
+    void SetQueueCapacity(size_t capacity);
+
+    /**
+     * @brief Начальный порог уровня для клиентов
+     * @param severity Сообщения ниже порога клиенты не формируют и не отправляют
+     *
+     * Порог публикуется в разделяемой памяти при запуске и меняется во время
+     * работы пульсом PULSE_SET_LEVEL (см. LoggerService::RequestLogLevel()).
+     *
+     * @note Должен вызываться до Run()
+     */
+    void SetLogLevel(ipc::Severity severity);
+
+    /**
+     * @brief Политика переполнения очереди между приемом и записью
+     * @param policy Блокировать прием или отбрасывать записи
+     * @param report_interval Период вывода строки "N messages dropped"
+     *
+     * С политикой отбрасывания поток приема не ждет приемник, и клиенты
+     * не блокируются в Send() из-за медленного диска: теряется полнота лога,
+     * а не задержка приложений. Число отброшенных записей пишется в приемник
+     * по таймерному пульсу PULSE_DROP_REPORT и при остановке.
+     *
+     * @note Должен вызываться до Run()
+     */
+    void SetOverloadPolicy(OverloadPolicy policy,
+                           std::chrono::milliseconds report_interval = std::chrono::seconds(1));
+
+    /**
+     * @brief Вывод процесса и потока отправителя после имени клиента
+     * @param show true - строки вида "... [INFO] name[pid:tid] text"
+     *
+     * Отправителя логгер узнает из сведений транспорта, клиент их не передает.
+     *
+     * @note Должен вызываться до Run()
+     */
+    void SetShowSenderIds(bool show);
+
+    /**
+     * @brief Период вывода метрик логгера в приемник
+     * @param period Период; ноль отключает вывод
+     *
+     * Строка метрик пишется по таймерному пульсу PULSE_STATS_TIMER, скорости
+     * и квантили задержек в ней считаются за прошедший период.
+     *
+     * @note Должен вызываться до Run()
+     */
+    void SetStatsInterval(std::chrono::milliseconds period);
+
+    /**
+     * @brief Подавление подряд идущих повторов записи отправителя
+     * @param summary_interval Период вывода сводок; ноль отключает подавление
+     *
+     * Запись, совпадающая с предыдущей записью того же процесса и потока
+     * (уровень и данные), не форматируется и не передается в Write(). Число
+     * повторов выводится строкой "last message repeated N times" с уровнем
+     * записи перед следующей другой записью отправителя, по таймерному пульсу
+     * PULSE_REPEAT_TIMER и при остановке. Так циклы повторных попыток не
+     * заполняют приемник одинаковыми строками.
+     *
+     * @note Должен вызываться до Run()
+     */
+    void SetRepeatSuppression(std::chrono::milliseconds summary_interval);
+
 protected:
     /**
      * @brief Запись форматированного сообщения в бэкенд
-     * @param formatted_message Отформатированная строка для записи
+     * @param formatted_message Отформатированная строка для записи (без перевода строки)
      *
      * Чисто виртуальный метод, который должны реализовать наследники
      * для конкретного механизма записи (файл, консоль, БД и т.д.).
      *
-     * @note Наследники должны гарантировать потокобезопасность этого метода
+     * @note Вызывается только из потока записи. Строка действительна
+     *       только на время вызова
      */
-    virtual void Write(std::string formatted_message) = 0;
+    virtual void Write(std::string_view formatted_message) = 0;
 
     /**
      * @brief Сброс буферов в конечное хранилище
@@ -73,10 +223,29 @@ protected:
      * Вызывается при остановке сервиса и по другим событиям.
      *
      * @note Наследники должны гарантировать, что после вызова Flush()
-     *       все данные записаны в конечное хранилище
+     *       все данные записаны в конечное хранилище. Вызывается только из потока записи
      */
     virtual void Flush() = 0;
 
+    /**
+     * @brief Запись строки клиентского сообщения
+     * @param level Уровень сообщения
+     * @param formatted_message Отформатированная строка (без перевода строки)
+     *
+     * По умолчанию вызывает Write(). Переопределяется наследниками, которым
+     * нужен уровень строки. Служебные строки логгера передаются прямо в Write().
+     *
+     * @note Вызывается только из потока записи
+     */
+    virtual void WriteMessage(ipc::MessageCode level, std::string_view formatted_message);
+
+    /**
+     * @brief Завершение записи после последней записи очереди
+     *
+     * Вызывается потоком записи при остановке логгера, до возврата из Run().
+     */
+    virtual void OnWriterStopped();
+
 private:
     /**
      * @brief Обработка IPC пульсов для системных событий
@@ -87,19 +256,59 @@ private:
      *
      * @note Вызывается из основного цикла MsgReceive в базовом классе
      */
-    void HandlePulse(const _pulse& ipc_pulse) override;
+    void HandlePulse(const ipc::Pulse& ipc_pulse) override;
 
     /**
      * @brief Обработка IPC сообщений с лог-данными
-     * @param ipc_message Ссылка на IPC сообщение
+     * @param info Отправитель: по pid поток записи находит имя клиента
+     * @param header Заголовок сообщения
+     * @param payload Данные сообщения целиком
      *
-     * Обрабатывает структурированные сообщения, содержащие данные для логирования.
-     * Форматирует сообщение с заголовком и передает на запись через Write().
+     * Копирует сообщение во внутреннюю очередь; форматирование и запись
+     * выполняет поток записи. Ответ клиенту отправляется сразу после возврата,
+     * на STATS_QUERY - ответ со снимком метрик.
      *
      * @note Вызывается из основного цикла MsgReceive в базовом классе
      */
-    void HandleMessage(int receive_id,
-                       const ipc::IpcMessage& ipc_message) override;
+    void HandleMessage(int receive_id, const ipc::ReceiveInfo& info,
+                       const ipc::MessageHeader& header, std::string_view payload) override;
+
+    /**
+     * @brief Постановка записей сообщения в очередь
+     * @param header Заголовок сообщения: код и время создания у клиента
+     * @param sender Отправитель сообщения
+     * @param counters Метрики текущего потока приема
+     */
+    void QueueMessage(const ipc::MessageHeader& header, std::string_view payload,
+                      const Sender& sender, LoggerStats::ThreadCounters& counters);
+
+    /**
+     * @brief Обработка пакета записей LOG_BATCH от асинхронного клиента
+     * @param payload Данные сообщения с пакетом
+     * @param time Время приема пакета для записей без метки клиента
+     * @param pid Процесс-отправитель пакета, поток берется из заголовка записи
+     * @return Число записей, поставленных в очередь
+     *
+     * Записи пакета ставятся в очередь в порядке следования, что сохраняет
+     * порядок сообщений каждого клиентского потока.
+     */
+    size_t HandleBatch(std::string_view payload, const timespec& time, uint32_t pid);
+
+    /**
+     * @brief Время записи: метка клиента или время приема
+     * @param timestamp Метка CaptureTicks() клиента (0 - не задана)
+     * @param received Время приема сообщения
+     */
+    timespec RecordTime(uint64_t timestamp, const timespec& received) const noexcept;
+
+    /**
+     * @brief Вычитывание всех записей из разделяемого буфера в очередь
+     *
+     * Вызывается по пульсу-звонку, а также перед обработкой сообщения из канала,
+     * чтобы записи клиента, ушедшие через буфер, не оказались позже его
+     * сообщений, отправленных через канал.
+     */
+    void DrainSharedRing();
 
     /**
      * @brief Обработка ошибок приема IPC сообщений
@@ -112,10 +321,33 @@ private:
      */
     void HandleReceiveError(int error_code) override;
 
+    /**
+     * @brief Постановка служебной строки логгера в очередь записи
+     * @param text Текст строки, пишется без времени и уровня
+     */
+    void PushRaw(std::string_view text);
+
+    /// @brief Цикл потока записи: форматирование и вывод записей очереди
+    void WriterLoop();
+
+    /**
+     * @brief Проверка записи на повтор предыдущей записи отправителя
+     * @return true - запись подавлена и не выводится
+     *
+     * Перед новой записью выводит сводку повторов предыдущей.
+     */
+    bool SuppressRepeat(const LogRecord& record);
+
+    /// @brief Вывод строки "last message repeated N times" от имени отправителя
+    void WriteRepeatSummary(const RepeatSummary& summary);
+
+    /// @brief Закрытие очереди и ожидание завершения потока записи
+    void StopWriter();
+
     /**
      * @brief Создание заголовка для лог-сообщения
      * @param code Код типа сообщения из ipc::MessageCode
-     * @return Строка с форматированным заголовком сообщения
+     * @return Строка с форматированным заголовком сообщения (статическая константа)
      *
      * Формирует стандартизированный заголовок сообщения, включающий:
      * - Временную метку
@@ -124,6 +356,97 @@ private:
      *
      * @example "2024-01-15 14:30:25 INFO"
      */
-    static std::string GetMessageHeader(const ipc::MessageCode& code);
+    static std::string_view GetMessageHeader(const ipc::MessageCode& code);
+
+    /// @brief Название порога уровня для служебных строк
+    static std::string_view GetLevelName(ipc::Severity severity);
+
+    /**
+     * @brief Сборка строки лога без выделения памяти
+     * @param message_time Отформатированная временная метка
+     * @param code Код типа сообщения
+     * @param sender_name Имя клиента
+     * @param sender_ids Процесс и поток отправителя (nullptr - не выводятся)
+     * @param message_text Текст сообщения
+     * @return Строка в буфере текущего потока, действительна до следующего вызова
+     *
+     * Буфер строки принадлежит потоку и переиспользуется, поэтому в установившемся
+     * режиме форматирование сообщения не выделяет память.
+     */
+    static std::string_view FormatLine(std::string_view message_time, ipc::MessageCode code,
+                                       std::string_view sender_name, const Sender* sender_ids,
+                                       std::string_view message_text);
+
+    /**
+     * @brief Запись строки лог-сообщения с учетом политики сброса
+     * @param code Код сообщения (LOG_ERROR и LOG_FATAL могут требовать немедленного сброса)
+     * @param line Отформатированная строка
+     *
+     * Сам сброс откладывается до CommitPending(), чтобы пачка записей
+     * завершалась не более чем одним Flush().
+     */
+    void WriteLine(ipc::MessageCode code, std::string_view line);
+
+    /// @brief Сброс, если по итогам записи сработал один из порогов политики
+    void CommitPending();
+
+    /// @brief Безусловный сброс и обнуление счетчиков политики
+    void FlushPending();
+
+    /// @brief Обработка таймерного пульса: сброс данных, ждущих дольше max_delay
+    void HandleFlushTimer();
+
+    /// @brief Снимок метрик вместе с состоянием очереди
+    ipc::LoggerStatsSnapshot CollectStats();
+
+    /// @brief Строка с числом записей, отброшенных после предыдущего отчета
+    void ReportDropped();
+
+    /// @brief Политика группового сброса и ее текущее состояние (поток записи)
+    FlushPolicy flush_policy_;
+    size_t pending_messages_{0};
+    size_t pending_bytes_{0};
+    timespec first_pending_time_{};
+    bool flush_due_{false};
+
+    /// @brief Форматы записей LOG_FORMATTED, зарегистрированные клиентами (поток записи)
+    FormatDecoder format_decoder_;
+
+    /// @brief Имена клиентов из LOG_REGISTER (поток записи)
+    SenderCache sender_cache_;
+    bool show_sender_ids_{false};
+
+    /// @brief Форматтер временных меток с кэшем по секундам (поток записи)
+    utils::time::TimestampFormatter timestamp_formatter_;
+
+    /// @brief Перевод меток клиентов в часы логгера (потоки приема)
+    utils::time::CaptureCalibration capture_calibration_;
+
+    /// @brief Порог уровня, общий для всех клиентов (nullptr, если сегмент недоступен)
+    ipc::Severity log_level_{ipc::SEVERITY_INFO};
+    std::unique_ptr<ipc::SharedLevel> shared_level_;
+
+    /// @brief Разделяемый буфер записей (nullptr, если транспорт не включен)
+    std::unique_ptr<ipc::SharedRing> shared_ring_;
+
+    /// @brief Подавление повторов и буфер сводок (поток записи)
+    std::chrono::milliseconds repeat_interval_{0};
+    DuplicateFilter duplicate_filter_;
+    std::vector<RepeatSummary> repeat_summaries_;
+
+    /// @brief Метрики логгера и счетчики потока записи
+    LoggerStats stats_;
+    LoggerStats::ThreadCounters* writer_stats_{nullptr};
+
+    /// @brief Период вывода метрик и снимок предыдущего вывода (под ходом очереди)
+    std::chrono::milliseconds stats_interval_{0};
+    ipc::LoggerStatsSnapshot last_stats_{};
+
+    /// @brief Очередь между потоком приема и потоком записи
+    size_t queue_capacity_{4096};
+    OverloadPolicy overload_policy_{OverloadPolicy::BLOCK};
+    std::chrono::milliseconds drop_report_interval_{std::chrono::seconds(1)};
+    std::unique_ptr<RecordQueue> queue_;
+    std::thread writer_;
 };
-} // namespace nexus::logger
\ No newline at end of file
+} // namespace nexus::logger
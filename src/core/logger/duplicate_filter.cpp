@@ -0,0 +1,83 @@
+#include "duplicate_filter.hpp"
+
+namespace nexus::logger {
+
+namespace {
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+uint64_t SenderKey(const Sender& sender) {
+    return static_cast<uint64_t>(sender.pid) << 32 | sender.tid;
+}
+} // namespace
+
+DuplicateFilter::DuplicateFilter(const size_t capacity) : capacity_(capacity > 0 ? capacity : 1) {
+}
+
+bool DuplicateFilter::Check(const Sender& sender, const ipc::MessageCode level,
+                            const std::string_view payload, const timespec& time,
+                            RepeatSummary& summary) {
+    summary.count = 0;
+
+    const uint64_t key = SenderKey(sender);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        // Отправители не сообщают о завершении: таблицу освобождает TakeSummaries()
+        if (entries_.size() >= capacity_) {
+            return false;
+        }
+        it = entries_.emplace(key, Entry{}).first;
+        it->second.size = SIZE_MAX;
+    }
+
+    Entry& entry = it->second;
+    entry.active = true;
+
+    const uint64_t hash = Hash(payload);
+    if (entry.hash == hash && entry.size == payload.size() && entry.level == level) {
+        ++entry.count;
+        entry.time = time;
+        return true;
+    }
+
+    if (entry.count > 0) {
+        summary = {sender, entry.level, entry.time, entry.count};
+    }
+    entry.hash = hash;
+    entry.size = payload.size();
+    entry.level = level;
+    entry.count = 0;
+    return false;
+}
+
+void DuplicateFilter::TakeSummaries(std::vector<RepeatSummary>& summaries) {
+    summaries.clear();
+
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        Entry& entry = it->second;
+        if (!entry.active) {
+            it = entries_.erase(it);
+            continue;
+        }
+
+        if (entry.count > 0) {
+            summaries.push_back({{static_cast<uint32_t>(it->first >> 32),
+                                  static_cast<uint32_t>(it->first)},
+                                 entry.level, entry.time, entry.count});
+            entry.count = 0;
+        }
+        entry.active = false;
+        ++it;
+    }
+}
+
+uint64_t DuplicateFilter::Hash(const std::string_view payload) noexcept {
+    uint64_t hash = kFnvOffsetBasis;
+    for (const char byte : payload) {
+        hash ^= static_cast<unsigned char>(byte);
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+} // namespace nexus::logger
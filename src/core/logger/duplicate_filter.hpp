@@ -0,0 +1,92 @@
+#pragma once
+
+/**
+ * @file duplicate_filter.hpp
+ * @brief Подавление подряд идущих одинаковых записей отправителя
+ */
+
+#include <time.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Logger
+#include "log_record.hpp"
+
+// Types
+#include "../../common/types/message_types.hpp"
+
+namespace nexus::logger {
+
+/**
+ * @brief Сводка подавленных повторов записи одного отправителя
+ */
+struct RepeatSummary {
+    Sender sender;           ///< Отправитель повторов
+    ipc::MessageCode level;  ///< Уровень повторяемой записи
+    timespec time;           ///< Время последнего повтора
+    uint64_t count;          ///< Число подавленных повторов
+};
+
+/**
+ * @class DuplicateFilter
+ * @brief Поиск повторов предыдущей записи каждого отправителя (процесс и поток)
+ *
+ * Для отправителя хранится только хеш FNV-1a данных его последней записи,
+ * ее размер и уровень: запись сравнивается до сборки текста, поэтому повтор
+ * не форматируется и не доходит до приемника. Записи LOG_FORMATTED сравниваются
+ * по двоичным данным (номер формата и аргументы).
+ *
+ * @note Не потокобезопасен: используется только потоком записи
+ */
+class DuplicateFilter {
+public:
+    /**
+     * @brief Конструктор
+     * @param capacity Наибольшее число отслеживаемых отправителей; записи
+     *                 отправителей сверх него не подавляются
+     */
+    explicit DuplicateFilter(size_t capacity = 1024);
+
+    /**
+     * @brief Проверка записи отправителя
+     * @param sender Отправитель записи
+     * @param level Уровень записи
+     * @param payload Данные записи
+     * @param time Время записи
+     * @param summary [out] Если запись новая: сводка повторов предыдущей записи
+     *                отправителя, которую нужно вывести перед ней (count 0 - повторов не было)
+     * @return true - запись повторяет предыдущую запись отправителя и не выводится
+     */
+    bool Check(const Sender& sender, ipc::MessageCode level, std::string_view payload,
+               const timespec& time, RepeatSummary& summary);
+
+    /**
+     * @brief Сводки повторов, накопленных после предыдущего вызова
+     * @param summaries [out] Сводки отправителей с ненулевым числом повторов
+     *
+     * Повторы после сводки снова подавляются и попадают в следующую сводку.
+     * Отправители без записей за два вызова подряд забываются.
+     */
+    void TakeSummaries(std::vector<RepeatSummary>& summaries);
+
+private:
+    struct Entry {
+        uint64_t hash;
+        size_t size;
+        ipc::MessageCode level;
+        timespec time;
+        uint64_t count;
+        bool active;
+    };
+
+    static uint64_t Hash(std::string_view payload) noexcept;
+
+    const size_t capacity_;
+    std::unordered_map<uint64_t, Entry> entries_;
+};
+
+} // namespace nexus::logger
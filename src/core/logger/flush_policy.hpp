@@ -0,0 +1,34 @@
+#pragma once
+
+/**
+ * @file flush_policy.hpp
+ * @brief Политика группового сброса буферов логгера
+ */
+
+#include <chrono>
+#include <cstddef>
+
+namespace nexus::logger {
+
+/**
+ * @brief Условия, при которых записанные сообщения сбрасываются в хранилище
+ *
+ * Сброс выполняется, как только выполнено любое из включенных условий.
+ * Нулевое значение порога отключает соответствующее условие.
+ * Значения по умолчанию соответствуют сбросу после каждого сообщения.
+ */
+struct FlushPolicy {
+    /// @brief Сброс после накопления N сообщений
+    size_t max_messages{1};
+
+    /// @brief Сброс после накопления M байт
+    size_t max_bytes{0};
+
+    /// @brief Сброс по таймерному пульсу, если данные ждут сброса дольше T
+    std::chrono::milliseconds max_delay{0};
+
+    /// @brief Немедленный сброс после сообщения LOG_ERROR
+    bool flush_on_error{true};
+};
+
+} // namespace nexus::logger
@@ -0,0 +1,189 @@
+#include "format_decoder.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+
+namespace nexus::logger {
+
+using namespace std::literals;
+
+namespace {
+uint64_t FormatKey(const uint32_t client_id, const uint32_t format_id) {
+    return static_cast<uint64_t>(client_id) << 32 | format_id;
+}
+
+// Чтение значения фиксированного размера с невыровненного адреса
+template <typename Value>
+bool ReadValue(std::string_view& args, Value& value) {
+    if (args.size() < sizeof(value)) {
+        return false;
+    }
+    std::memcpy(&value, args.data(), sizeof(value));
+    args.remove_prefix(sizeof(value));
+    return true;
+}
+
+template <typename Integer>
+void AppendInteger(std::string& out, const Integer value, const int base = 10) {
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, base);
+    out.append(buffer, static_cast<size_t>(result.ptr - buffer));
+}
+} // namespace
+
+void FormatDecoder::Register(std::string_view payload) {
+    ipc::FormatRegistration registration{};
+    if (!ReadValue(payload, registration)) {
+        return;
+    }
+
+    // Текст формата без завершающих нулей
+    while (!payload.empty() && payload.back() == '\0') {
+        payload.remove_suffix(1);
+    }
+    formats_[FormatKey(registration.client_id, registration.format_id)].assign(payload.data(),
+                                                                                payload.size());
+}
+
+std::string_view FormatDecoder::Decode(std::string_view payload, ipc::MessageCode& level) {
+    ipc::FormattedHeader header{};
+    if (!ReadValue(payload, header)) {
+        level = ipc::LOG_ERROR;
+        return "Malformed formatted record"sv;
+    }
+    level = header.level;
+
+    const auto it = formats_.find(FormatKey(header.client_id, header.format_id));
+    if (it == formats_.end()) {
+        text_.assign("Unregistered format #"sv);
+        AppendInteger(text_, header.format_id);
+        text_.append(" of client "sv);
+        AppendInteger(text_, header.client_id);
+        return text_;
+    }
+
+    text_.clear();
+    Substitute(it->second, payload, header.arg_count);
+    return text_;
+}
+
+void FormatDecoder::Substitute(const std::string_view format, std::string_view args,
+                               uint8_t arg_count) {
+    size_t literal_start = 0;
+    for (size_t i = 0; i + 1 < format.size(); ++i) {
+        const char current = format[i];
+        const char next = format[i + 1];
+        const bool escape = (current == '{' && next == '{') || (current == '}' && next == '}');
+        const bool placeholder = current == '{' && next == '}';
+        if (!escape && !placeholder) {
+            continue;
+        }
+
+        text_.append(format.substr(literal_start, i - literal_start));
+        if (escape) {
+            text_.push_back(current);
+        } else if (arg_count > 0 && AppendArgument(args)) {
+            --arg_count;
+        } else {
+            // Аргумент отброшен клиентом (не поместился в запись) или поврежден
+            arg_count = 0;
+            text_.append("{}"sv);
+        }
+        ++i;
+        literal_start = i + 1;
+    }
+    text_.append(format.substr(std::min(literal_start, format.size())));
+}
+
+bool FormatDecoder::AppendArgument(std::string_view& args) {
+    ipc::ArgType type{};
+    if (!ReadValue(args, type)) {
+        return false;
+    }
+
+    switch (type) {
+        case ipc::ArgType::INT32: {
+            int32_t value = 0;
+            if (!ReadValue(args, value)) {
+                return false;
+            }
+            AppendInteger(text_, value);
+            return true;
+        }
+        case ipc::ArgType::UINT32: {
+            uint32_t value = 0;
+            if (!ReadValue(args, value)) {
+                return false;
+            }
+            AppendInteger(text_, value);
+            return true;
+        }
+        case ipc::ArgType::INT64: {
+            int64_t value = 0;
+            if (!ReadValue(args, value)) {
+                return false;
+            }
+            AppendInteger(text_, value);
+            return true;
+        }
+        case ipc::ArgType::UINT64: {
+            uint64_t value = 0;
+            if (!ReadValue(args, value)) {
+                return false;
+            }
+            AppendInteger(text_, value);
+            return true;
+        }
+        case ipc::ArgType::DOUBLE: {
+            double value = 0;
+            if (!ReadValue(args, value)) {
+                return false;
+            }
+            char buffer[32];
+            const int written = snprintf(buffer, sizeof(buffer), "%g", value);
+            if (written > 0) {
+                text_.append(buffer, std::min(static_cast<size_t>(written), sizeof(buffer) - 1));
+            }
+            return true;
+        }
+        case ipc::ArgType::BOOL: {
+            uint8_t value = 0;
+            if (!ReadValue(args, value)) {
+                return false;
+            }
+            text_.append(value != 0 ? "true"sv : "false"sv);
+            return true;
+        }
+        case ipc::ArgType::CHAR: {
+            char value = 0;
+            if (!ReadValue(args, value)) {
+                return false;
+            }
+            text_.push_back(value);
+            return true;
+        }
+        case ipc::ArgType::STRING: {
+            uint16_t length = 0;
+            if (!ReadValue(args, length) || args.size() < length) {
+                return false;
+            }
+            text_.append(args.substr(0, length));
+            args.remove_prefix(length);
+            return true;
+        }
+        case ipc::ArgType::POINTER: {
+            uint64_t value = 0;
+            if (!ReadValue(args, value)) {
+                return false;
+            }
+            text_.append("0x"sv);
+            AppendInteger(text_, value, 16);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace nexus::logger
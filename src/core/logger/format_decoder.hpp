@@ -0,0 +1,62 @@
+#pragma once
+
+/**
+ * @file format_decoder.hpp
+ * @brief Восстановление текста записей LOG_FORMATTED на стороне логгера
+ */
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Types
+#include "../../common/types/format_types.hpp"
+
+namespace nexus::logger {
+
+/**
+ * @class FormatDecoder
+ * @brief Таблица зарегистрированных форматов и подстановка в них аргументов
+ *
+ * Форматы хранятся по паре (идентификатор клиента, номер формата), поскольку
+ * номера выдаются каждым клиентским процессом независимо. Регистрация и записи
+ * проходят через одну очередь логгера, поэтому формат всегда известен раньше,
+ * чем первая запись, которая на него ссылается.
+ *
+ * @note Не потокобезопасен: используется только потоком записи
+ */
+class FormatDecoder {
+public:
+    /**
+     * @brief Сохранение формата из сообщения LOG_FORMAT
+     * @param payload FormatRegistration и текст формата
+     */
+    void Register(std::string_view payload);
+
+    /**
+     * @brief Восстановление текста записи LOG_FORMATTED
+     * @param payload FormattedHeader и аргументы записи
+     * @param level [out] Уровень записи из заголовка
+     * @return Текст записи; строка действительна до следующего вызова
+     */
+    std::string_view Decode(std::string_view payload, ipc::MessageCode& level);
+
+private:
+    /// @brief Подстановка аргументов записи в формат
+    void Substitute(std::string_view format, std::string_view args, uint8_t arg_count);
+
+    /**
+     * @brief Преобразование очередного аргумента в текст
+     * @param args [in,out] Остаток аргументов записи, сдвигается за прочитанный аргумент
+     * @return false, если аргумент поврежден или неизвестного типа
+     */
+    bool AppendArgument(std::string_view& args);
+
+    std::unordered_map<uint64_t, std::string> formats_;
+
+    /// @brief Буфер восстановленного текста, переиспользуемый между записями
+    std::string text_;
+};
+
+} // namespace nexus::logger
@@ -0,0 +1,40 @@
+#include "format_registry.hpp"
+
+#include <mutex>
+#include <vector>
+
+namespace nexus::logger {
+
+namespace {
+// Реестр создается при первом обращении: макросы могут вызываться
+// из статических инициализаторов других единиц трансляции
+std::mutex& RegistryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<const char*>& RegistryFormats() {
+    static std::vector<const char*> formats;
+    return formats;
+}
+} // namespace
+
+uint32_t FormatRegistry::Register(const char* format) {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    auto& formats = RegistryFormats();
+    formats.push_back(format);
+    return static_cast<uint32_t>(formats.size() - 1);
+}
+
+size_t FormatRegistry::Size() {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    return RegistryFormats().size();
+}
+
+const char* FormatRegistry::Get(const uint32_t format_id) {
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    const auto& formats = RegistryFormats();
+    return format_id < formats.size() ? formats[format_id] : "";
+}
+
+} // namespace nexus::logger
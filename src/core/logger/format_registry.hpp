@@ -0,0 +1,66 @@
+#pragma once
+
+/**
+ * @file format_registry.hpp
+ * @brief Реестр строк формата клиентского процесса
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace nexus::logger {
+
+/**
+ * @class FormatRegistry
+ * @brief Нумерация строк формата макросов LOG_*_FMT в пределах процесса
+ *
+ * Каждое место вызова регистрирует свою строку один раз (в статической переменной
+ * макроса) и дальше передает логгеру только номер формата. Номера выдаются подряд
+ * с нуля, поэтому LoggerService отправляет логгеру все еще не переданные форматы
+ * одним проходом по диапазону номеров.
+ *
+ * @note Потокобезопасность: thread-safe. Строки формата должны жить до конца
+ *       процесса (строковые литералы)
+ */
+class FormatRegistry {
+public:
+    /**
+     * @brief Регистрация строки формата
+     * @param format Строка формата с подстановками "{}"
+     * @return Номер формата
+     */
+    static uint32_t Register(const char* format);
+
+    /**
+     * @brief Число зарегистрированных форматов
+     */
+    static size_t Size();
+
+    /**
+     * @brief Строка формата по номеру
+     * @param format_id Номер, полученный от Register()
+     */
+    static const char* Get(uint32_t format_id);
+};
+
+/**
+ * @brief Число подстановок "{}" в строке формата ("{{" и "}}" - экранированные скобки)
+ *
+ * Вычисляется при компиляции: макросы LOG_*_FMT сверяют его с числом аргументов.
+ */
+constexpr size_t CountPlaceholders(const std::string_view format) {
+    size_t count = 0;
+    for (size_t i = 0; i + 1 < format.size(); ++i) {
+        if ((format[i] == '{' && format[i + 1] == '{')
+            || (format[i] == '}' && format[i + 1] == '}')) {
+            ++i;
+        } else if (format[i] == '{' && format[i + 1] == '}') {
+            ++count;
+            ++i;
+        }
+    }
+    return count;
+}
+
+} // namespace nexus::logger
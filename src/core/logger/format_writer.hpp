@@ -0,0 +1,133 @@
+#pragma once
+
+/**
+ * @file format_writer.hpp
+ * @brief Кодирование аргументов записи LOG_FORMATTED без форматирования
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+// Types
+#include "../../common/types/format_types.hpp"
+
+namespace nexus::logger {
+
+/**
+ * @class FormatWriter
+ * @brief Сборка бинарной записи LOG_FORMATTED в буфере на стеке
+ *
+ * Аргументы копируются в сыром виде с тегом типа; преобразование в текст
+ * выполняет логгер в потоке записи. Аргумент, не помещающийся в kMaxFormattedPayload,
+ * отбрасывается вместе со всеми последующими (строка обрезается до свободного места).
+ *
+ * @note Не потокобезопасен: экземпляр живет в пределах одного вызова макроса
+ */
+class FormatWriter {
+public:
+    FormatWriter(const ipc::MessageCode level, const uint32_t client_id,
+                 const uint32_t format_id) noexcept {
+        header_.level = level;
+        header_.client_id = client_id;
+        header_.format_id = format_id;
+        header_.arg_count = 0;
+    }
+
+    FormatWriter(const FormatWriter&) = delete;
+    FormatWriter& operator=(const FormatWriter&) = delete;
+
+    /**
+     * @brief Добавление аргумента
+     *
+     * Поддерживаются целые, перечисления, числа с плавающей точкой, bool, char,
+     * строки (const char*, std::string, std::string_view) и указатели.
+     */
+    template <typename T>
+    void Append(const T& value) noexcept {
+        using Type = std::decay_t<T>;
+
+        if constexpr (std::is_same_v<Type, bool>) {
+            AppendValue(ipc::ArgType::BOOL, static_cast<uint8_t>(value));
+        } else if constexpr (std::is_same_v<Type, char>) {
+            AppendValue(ipc::ArgType::CHAR, value);
+        } else if constexpr (std::is_enum_v<Type>) {
+            Append(static_cast<std::underlying_type_t<Type>>(value));
+        } else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>) {
+            if constexpr (sizeof(Type) <= sizeof(int32_t)) {
+                AppendValue(ipc::ArgType::INT32, static_cast<int32_t>(value));
+            } else {
+                AppendValue(ipc::ArgType::INT64, static_cast<int64_t>(value));
+            }
+        } else if constexpr (std::is_integral_v<Type>) {
+            if constexpr (sizeof(Type) <= sizeof(uint32_t)) {
+                AppendValue(ipc::ArgType::UINT32, static_cast<uint32_t>(value));
+            } else {
+                AppendValue(ipc::ArgType::UINT64, static_cast<uint64_t>(value));
+            }
+        } else if constexpr (std::is_floating_point_v<Type>) {
+            AppendValue(ipc::ArgType::DOUBLE, static_cast<double>(value));
+        } else if constexpr (std::is_same_v<Type, const char*> || std::is_same_v<Type, char*>) {
+            AppendString(value != nullptr ? std::string_view(value) : std::string_view("(null)"));
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            AppendString(value);
+        } else if constexpr (std::is_pointer_v<Type>) {
+            AppendValue(ipc::ArgType::POINTER,
+                        static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+        } else {
+            static_assert(!sizeof(T), "Unsupported LOG_*_FMT argument type");
+        }
+    }
+
+    /**
+     * @brief Готовая запись: заголовок и аргументы
+     */
+    std::string_view View() noexcept {
+        std::memcpy(buffer_, &header_, sizeof(header_));
+        return {buffer_, size_};
+    }
+
+private:
+    template <typename Value>
+    void AppendValue(const ipc::ArgType type, const Value value) noexcept {
+        if (full_ || size_ + sizeof(type) + sizeof(value) > sizeof(buffer_)) {
+            full_ = true;
+            return;
+        }
+
+        std::memcpy(buffer_ + size_, &type, sizeof(type));
+        std::memcpy(buffer_ + size_ + sizeof(type), &value, sizeof(value));
+        size_ += sizeof(type) + sizeof(value);
+        ++header_.arg_count;
+    }
+
+    void AppendString(const std::string_view value) noexcept {
+        constexpr size_t kStringHeader = sizeof(ipc::ArgType) + sizeof(uint16_t);
+        if (full_ || size_ + kStringHeader > sizeof(buffer_)) {
+            full_ = true;
+            return;
+        }
+
+        const auto type = ipc::ArgType::STRING;
+        const auto length = static_cast<uint16_t>(
+            std::min(value.size(), sizeof(buffer_) - size_ - kStringHeader)
+        );
+        std::memcpy(buffer_ + size_, &type, sizeof(type));
+        std::memcpy(buffer_ + size_ + sizeof(type), &length, sizeof(length));
+        std::memcpy(buffer_ + size_ + kStringHeader, value.data(), length);
+        size_ += kStringHeader + length;
+        ++header_.arg_count;
+
+        // Обрезанная строка занимает остаток буфера
+        full_ = length < value.size();
+    }
+
+    ipc::FormattedHeader header_{};
+    char buffer_[ipc::kMaxFormattedPayload];
+    size_t size_{sizeof(ipc::FormattedHeader)};
+    bool full_{false};
+};
+
+} // namespace nexus::logger
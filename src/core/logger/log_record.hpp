@@ -0,0 +1,61 @@
+#pragma once
+
+/**
+ * @file log_record.hpp
+ * @brief Запись лога, передаваемая от потока приема потоку записи
+ */
+
+#include <time.h>
+
+#include <cstdint>
+#include <string>
+
+// Types
+#include "../../common/types/message_types.hpp"
+
+namespace nexus::logger {
+
+/**
+ * @brief Вид записи во внутренней очереди логгера
+ */
+enum class RecordKind : uint8_t {
+    MESSAGE, ///< Клиентское сообщение: форматируется с временем и уровнем
+    RAW,     ///< Служебная строка логгера: пишется как есть и сбрасывается сразу
+    FLUSH,   ///< Команда проверки таймерного сброса, текста не содержит
+    FORMAT,  ///< Регистрация строки формата LOG_FORMAT, в вывод не попадает
+    CLIENT,  ///< Регистрация имени клиента LOG_REGISTER, в вывод не попадает
+    REPEATS  ///< Команда вывода сводок подавленных повторов, текста не содержит
+};
+
+/**
+ * @brief Отправитель записи по сведениям транспорта
+ */
+struct Sender {
+    uint32_t pid{0}; ///< Процесс клиента (0 - неизвестен)
+    uint32_t tid{0}; ///< Поток клиента (0 - неизвестен)
+};
+
+/**
+ * @brief Запись лога во внутренней очереди BaseLogger
+ *
+ * Строка text сохраняет выделенную емкость при переиспользовании слота очереди,
+ * поэтому в установившемся режиме копирование записи не выделяет память.
+ */
+struct LogRecord {
+    RecordKind kind{RecordKind::MESSAGE};
+    ipc::MessageCode code{ipc::LOG_INFO};
+
+    /// @brief Глобальный порядковый номер приема (общий для записей одного пакета)
+    uint64_t sequence{0};
+
+    /// @brief Время приема сообщения логгером
+    timespec time{};
+
+    /// @brief Отправитель: имя клиента логгер находит по pid
+    Sender sender{};
+
+    /// @brief Текст сообщения; для LOG_FORMATTED и FORMAT - двоичные данные клиента
+    std::string text;
+};
+
+} // namespace nexus::logger
@@ -0,0 +1,96 @@
+#pragma once
+
+/**
+ * @file log_sampler.hpp
+ * @brief Состояние места вызова для макросов прореживания LOG_*_EVERY_N и т.п.
+ */
+
+#include <atomic>
+#include <cstdint>
+
+// Utils
+#include "../../common/utils/time_utils.hpp"
+
+namespace nexus::logger {
+
+/**
+ * @class EveryNSampler
+ * @brief Пропуск всех записей места вызова, кроме каждой N-й (1-я, N+1-я, ...)
+ *
+ * Решение - один relaxed fetch_add. Между выведенными записями подавлено
+ * ровно N-1 записей.
+ */
+class EveryNSampler {
+public:
+    /**
+     * @param n Период; 0 и 1 - выводится каждая запись
+     * @param suppressed [out] Число записей, подавленных после предыдущей выведенной
+     * @return true - запись выводится
+     */
+    bool Sample(const uint64_t n, uint64_t& suppressed) noexcept {
+        const uint64_t index = count_.fetch_add(1, std::memory_order_relaxed);
+        if (n > 1 && index % n != 0) {
+            return false;
+        }
+        suppressed = index == 0 || n <= 1 ? 0 : n - 1;
+        return true;
+    }
+
+private:
+    std::atomic<uint64_t> count_{0};
+};
+
+/**
+ * @class FirstNSampler
+ * @brief Вывод только первых N записей места вызова
+ *
+ * После N записей решение - одна relaxed-загрузка без записи в общую линию кэша.
+ */
+class FirstNSampler {
+public:
+    /// @brief true - запись выводится
+    bool Sample(const uint64_t n) noexcept {
+        return count_.load(std::memory_order_relaxed) < n
+               && count_.fetch_add(1, std::memory_order_relaxed) < n;
+    }
+
+private:
+    std::atomic<uint64_t> count_{0};
+};
+
+/**
+ * @class IntervalSampler
+ * @brief Вывод не более одной записи места вызова за период
+ *
+ * Время берется по грубым монотонным часам (без системного вызова). Подавленная
+ * запись стоит одной relaxed-загрузки и одного fetch_add счетчика подавленных,
+ * который забирает следующая выведенная запись.
+ */
+class IntervalSampler {
+public:
+    /**
+     * @param period_ms Период в миллисекундах
+     * @param suppressed [out] Число записей, подавленных после предыдущей выведенной
+     * @return true - запись выводится
+     */
+    bool Sample(const int64_t period_ms, uint64_t& suppressed) noexcept {
+        const int64_t now = utils::time::ToMilliseconds(utils::time::GetCoarseMonotonicTime());
+        int64_t next = next_ms_.load(std::memory_order_relaxed);
+
+        // Из нескольких потоков, увидевших истекший период, выводит один
+        if (now < next
+            || !next_ms_.compare_exchange_strong(next, now + period_ms,
+                                                 std::memory_order_relaxed)) {
+            suppressed_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    std::atomic<int64_t> next_ms_{0};
+    std::atomic<uint64_t> suppressed_{0};
+};
+
+} // namespace nexus::logger
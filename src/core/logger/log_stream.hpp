@@ -0,0 +1,196 @@
+#pragma once
+
+/**
+ * @file log_stream.hpp
+ * @brief Потоковая сборка текста записи без выделения памяти
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+
+// Logger
+#include "logger_service.hpp"
+
+namespace nexus::logger {
+
+/// @brief Размер буфера текста записи LOG_*_S, более длинный текст обрезается
+constexpr size_t kStreamBufferSize = 4096;
+
+/**
+ * @class LogStream
+ * @brief Сборка текста записи операторами << в буфере потока
+ *
+ * Текст пишется сразу в буфер, который уходит логгеру данными сообщения,
+ * без промежуточных std::string: целые и числа с плавающей точкой
+ * преобразуются std::to_chars, строки копируются. Запись отправляется
+ * в деструкторе, то есть в конце выражения LOG_*_S.
+ *
+ * Буфер выделяется один раз на поток. Если при сборке записи вычисляется
+ * выражение, которое само пишет LOG_*_S, вложенная запись получает
+ * собственный буфер из кучи.
+ *
+ * @note Вывод значений совпадает с LOG_*_FMT: bool - true/false,
+ *       указатели - 0x<hex>, числа с плавающей точкой - как "%g"
+ */
+class LogStream {
+public:
+    explicit LogStream(const ipc::MessageCode level) noexcept : level_(level) {
+        Buffer& buffer = ThreadBuffer();
+        if (!buffer.busy) {
+            buffer.busy = true;
+            buffer_ = &buffer;
+            data_ = buffer.data;
+        } else {
+            nested_.reset(new (std::nothrow) char[kStreamBufferSize]);
+            data_ = nested_.get();
+        }
+    }
+
+    ~LogStream() {
+        if (data_ != nullptr) {
+            if (auto* logger = LoggerService::Instance()) {
+                try {
+                    logger->SendLog(level_, {data_, size_});
+                } catch (...) {
+                    // Ошибка доставки не должна выходить из деструктора
+                }
+            }
+        }
+        if (buffer_ != nullptr) {
+            buffer_->busy = false;
+        }
+    }
+
+    LogStream(const LogStream&) = delete;
+    LogStream& operator=(const LogStream&) = delete;
+
+    LogStream& operator<<(const std::string_view value) noexcept {
+        Write(value.data(), value.size());
+        return *this;
+    }
+
+    LogStream& operator<<(const char* value) noexcept {
+        return *this << (value != nullptr ? std::string_view(value) : std::string_view("(null)"));
+    }
+
+    LogStream& operator<<(char* value) noexcept {
+        return *this << static_cast<const char*>(value);
+    }
+
+    LogStream& operator<<(const char value) noexcept {
+        Write(&value, 1);
+        return *this;
+    }
+
+    LogStream& operator<<(const bool value) noexcept {
+        return *this << (value ? std::string_view("true") : std::string_view("false"));
+    }
+
+    /**
+     * @brief Целые, перечисления, числа с плавающей точкой, указатели
+     * и типы, приводимые к std::string_view (std::string)
+     */
+    template <typename T>
+    LogStream& operator<<(const T& value) noexcept {
+        using Type = std::decay_t<T>;
+
+        if constexpr (std::is_enum_v<Type>) {
+            *this << static_cast<std::underlying_type_t<Type>>(value);
+        } else if constexpr (std::is_integral_v<Type>) {
+            // signed/unsigned char выводятся числом, как в LOG_*_FMT
+            using Wide = std::conditional_t<std::is_signed_v<Type>, int64_t, uint64_t>;
+            WriteChars(static_cast<Wide>(value));
+        } else if constexpr (std::is_floating_point_v<Type>) {
+            WriteFloat(static_cast<double>(value));
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            *this << std::string_view(value);
+        } else if constexpr (std::is_pointer_v<Type>) {
+            *this << std::string_view("0x");
+            WriteChars(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)), 16);
+        } else {
+            static_assert(!sizeof(T), "Unsupported LOG_*_S argument type");
+        }
+        return *this;
+    }
+
+private:
+    struct Buffer {
+        char data[kStreamBufferSize];
+        bool busy{false};
+    };
+
+    static Buffer& ThreadBuffer() noexcept {
+        thread_local Buffer buffer;
+        return buffer;
+    }
+
+    char* End() const noexcept {
+        return data_ + kStreamBufferSize;
+    }
+
+    void Write(const char* data, const size_t size) noexcept {
+        if (data_ == nullptr) {
+            return;
+        }
+        const size_t length = std::min(size, kStreamBufferSize - size_);
+        std::memcpy(data_ + size_, data, length);
+        size_ += length;
+    }
+
+    template <typename Integer>
+    void WriteChars(const Integer value, const int base = 10) noexcept {
+        if (data_ == nullptr) {
+            return;
+        }
+        // Число, не поместившееся целиком, не выводится: буфер уже заполнен
+        const auto result = std::to_chars(data_ + size_, End(), value, base);
+        if (result.ec == std::errc()) {
+            size_ = static_cast<size_t>(result.ptr - data_);
+        } else {
+            size_ = kStreamBufferSize;
+        }
+    }
+
+    void WriteFloat(const double value) noexcept {
+        if (data_ == nullptr) {
+            return;
+        }
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        const auto result =
+            std::to_chars(data_ + size_, End(), value, std::chars_format::general, 6);
+        size_ = result.ec == std::errc() ? static_cast<size_t>(result.ptr - data_)
+                                         : kStreamBufferSize;
+#else
+        // Библиотека без to_chars для чисел с плавающей точкой
+        char buffer[32];
+        const int written = snprintf(buffer, sizeof(buffer), "%g", value);
+        if (written > 0) {
+            Write(buffer, std::min(static_cast<size_t>(written), sizeof(buffer) - 1));
+        }
+#endif
+    }
+
+    const ipc::MessageCode level_;
+    Buffer* buffer_{nullptr};
+    std::unique_ptr<char[]> nested_;
+    char* data_{nullptr};
+    size_t size_{0};
+};
+
+/**
+ * @brief Приведение выражения LOG_*_S к void, чтобы макрос был выражением
+ *
+ * operator& имеет приоритет ниже <<, поэтому применяется к готовой записи.
+ */
+struct LogStreamVoidify {
+    void operator&(const LogStream&) const noexcept {
+    }
+};
+
+} // namespace nexus::logger
@@ -3,30 +3,394 @@
 /**
  * @file logger_macros.hpp
  * @brief Макросы для удобного использования системы логирования
+ *
+ * Уровни ниже NEXUS_LOG_MIN_LEVEL отбрасываются при компиляции: условие вызова
+ * становится константой false, и компилятор удаляет вызов вместе с вычислением
+ * аргументов (выражения при этом проверяются на корректность). Остальные уровни
+ * проверяются по порогу времени выполнения до вычисления сообщения или аргументов.
+ *
+ * @example Сборка, в которой TRACE и DEBUG не попадают в код:
+ *          -DNEXUS_LOG_MIN_LEVEL=NEXUS_LOG_LEVEL_INFO
  */
 
+#include <string>
+#include <tuple>
+
+#include "format_registry.hpp"
+#include "log_sampler.hpp"
+#include "log_stream.hpp"
 #include "logger_service.hpp"
 
+// Значения совпадают с ipc::Severity
+#define NEXUS_LOG_LEVEL_TRACE 0
+#define NEXUS_LOG_LEVEL_DEBUG 1
+#define NEXUS_LOG_LEVEL_INFO 2
+#define NEXUS_LOG_LEVEL_WARN 3
+#define NEXUS_LOG_LEVEL_ERROR 4
+#define NEXUS_LOG_LEVEL_FATAL 5
+#define NEXUS_LOG_LEVEL_OFF 6
+
 /**
- * @def LOG_INFO(message)
- * @brief Макрос для отправки информационного сообщения
- * @param message Сообщение для логирования (может быть строкой или выражением)
+ * @def NEXUS_LOG_MIN_LEVEL
+ * @brief Порог времени компиляции: уровни ниже него не попадают в код
+ */
+#ifndef NEXUS_LOG_MIN_LEVEL
+#define NEXUS_LOG_MIN_LEVEL NEXUS_LOG_LEVEL_TRACE
+#endif
+
+/**
+ * @def NEXUS_LOG_ENABLED(level)
+ * @brief Проверка уровня: сначала порог компиляции, затем порог времени выполнения
+ * @param level Код уровня ipc::MessageCode
+ */
+#define NEXUS_LOG_ENABLED(level) \
+    (::nexus::ipc::SeverityOf(level) >= NEXUS_LOG_MIN_LEVEL \
+     && ::nexus::logger::LoggerService::IsEnabled(::nexus::ipc::SeverityOf(level)))
+
+/**
+ * @def NEXUS_LOG(level, message)
+ * @brief Отправка сообщения заданного уровня
+ * @param message Сообщение для логирования, вычисляется только для включенного уровня
  */
-#define LOG_INFO(message) \
+#define NEXUS_LOG(level, message) \
     do { \
-        if (auto* logger = ::nexus::logger::LoggerService::Instance()) { \
-            logger->SendInfo(std::string(message)); \
+        if (NEXUS_LOG_ENABLED(level)) { \
+            if (auto* logger = ::nexus::logger::LoggerService::Instance()) { \
+                logger->SendLog(level, std::string(message)); \
+            } \
         } \
     } while(0)
 
+/**
+ * @def LOG_TRACE(message)
+ * @brief Макрос для отправки трассировочного сообщения
+ * @param message Сообщение для логирования (может быть строкой или выражением)
+ */
+#define LOG_TRACE(message) NEXUS_LOG(::nexus::ipc::LOG_TRACE, message)
+
+/**
+ * @def LOG_DEBUG(message)
+ * @brief Макрос для отправки отладочного сообщения
+ * @param message Сообщение для логирования (может быть строкой или выражением)
+ */
+#define LOG_DEBUG(message) NEXUS_LOG(::nexus::ipc::LOG_DEBUG, message)
+
+/**
+ * @def LOG_INFO(message)
+ * @brief Макрос для отправки информационного сообщения
+ * @param message Сообщение для логирования (может быть строкой или выражением)
+ */
+#define LOG_INFO(message) NEXUS_LOG(::nexus::ipc::LOG_INFO, message)
+
+/**
+ * @def LOG_WARN(message)
+ * @brief Макрос для отправки предупреждения
+ * @param message Сообщение для логирования (может быть строкой или выражением)
+ */
+#define LOG_WARN(message) NEXUS_LOG(::nexus::ipc::LOG_WARN, message)
+
 /**
  * @def LOG_ERROR(message)
  * @brief Макрос для отправки сообщения об ошибке
  * @param message Сообщение для логирования (может быть строкой или выражением)
  */
-#define LOG_ERROR(message) \
+#define LOG_ERROR(message) NEXUS_LOG(::nexus::ipc::LOG_ERROR, message)
+
+/**
+ * @def LOG_FATAL(message)
+ * @brief Макрос для отправки сообщения о фатальной ошибке (выполнение не прерывается)
+ * @param message Сообщение для логирования (может быть строкой или выражением)
+ */
+#define LOG_FATAL(message) NEXUS_LOG(::nexus::ipc::LOG_FATAL, message)
+
+/**
+ * @def NEXUS_LOG_FMT(level, format, ...)
+ * @brief Отправка записи с отложенным форматированием
+ *
+ * Строка формата регистрируется один раз при первом выполнении места вызова
+ * с включенным уровнем, дальше логгеру передаются только номер формата и аргументы
+ * в двоичном виде. Число подстановок "{}" сверяется с числом аргументов при компиляции.
+ */
+#define NEXUS_LOG_FMT(level, format, ...) \
     do { \
-        if (auto* logger = ::nexus::logger::LoggerService::Instance()) { \
-            logger->SendError(std::string(message)); \
+        static_assert(::nexus::logger::CountPlaceholders(format) \
+                      == std::tuple_size_v<decltype(std::make_tuple(__VA_ARGS__))>, \
+                      "Placeholder count does not match argument count"); \
+        if (NEXUS_LOG_ENABLED(level)) { \
+            static const uint32_t nexus_format_id = \
+                ::nexus::logger::FormatRegistry::Register(format); \
+            if (auto* logger = ::nexus::logger::LoggerService::Instance()) { \
+                logger->SendFormatted(level, nexus_format_id, ##__VA_ARGS__); \
+            } \
         } \
     } while(0)
+
+/**
+ * @def LOG_TRACE_FMT(format, ...)
+ * @brief Трассировочное сообщение с отложенным форматированием
+ * @param format Строковый литерал с подстановками "{}"
+ */
+#define LOG_TRACE_FMT(format, ...) NEXUS_LOG_FMT(::nexus::ipc::LOG_TRACE, format, ##__VA_ARGS__)
+
+/**
+ * @def LOG_DEBUG_FMT(format, ...)
+ * @brief Отладочное сообщение с отложенным форматированием
+ * @param format Строковый литерал с подстановками "{}"
+ */
+#define LOG_DEBUG_FMT(format, ...) NEXUS_LOG_FMT(::nexus::ipc::LOG_DEBUG, format, ##__VA_ARGS__)
+
+/**
+ * @def LOG_INFO_FMT(format, ...)
+ * @brief Информационное сообщение с отложенным форматированием
+ * @param format Строковый литерал с подстановками "{}"
+ *
+ * @example LOG_INFO_FMT("Processing item {} of {}", i, count);
+ */
+#define LOG_INFO_FMT(format, ...) NEXUS_LOG_FMT(::nexus::ipc::LOG_INFO, format, ##__VA_ARGS__)
+
+/**
+ * @def LOG_WARN_FMT(format, ...)
+ * @brief Предупреждение с отложенным форматированием
+ * @param format Строковый литерал с подстановками "{}"
+ */
+#define LOG_WARN_FMT(format, ...) NEXUS_LOG_FMT(::nexus::ipc::LOG_WARN, format, ##__VA_ARGS__)
+
+/**
+ * @def LOG_ERROR_FMT(format, ...)
+ * @brief Сообщение об ошибке с отложенным форматированием
+ * @param format Строковый литерал с подстановками "{}"
+ */
+#define LOG_ERROR_FMT(format, ...) NEXUS_LOG_FMT(::nexus::ipc::LOG_ERROR, format, ##__VA_ARGS__)
+
+/**
+ * @def LOG_FATAL_FMT(format, ...)
+ * @brief Сообщение о фатальной ошибке с отложенным форматированием
+ * @param format Строковый литерал с подстановками "{}"
+ */
+#define LOG_FATAL_FMT(format, ...) NEXUS_LOG_FMT(::nexus::ipc::LOG_FATAL, format, ##__VA_ARGS__)
+
+/**
+ * @def NEXUS_LOG_S(level)
+ * @brief Запись, собираемая операторами << без промежуточных строк
+ *
+ * Выражение после макроса вычисляется только для включенного уровня.
+ * Макрос - выражение, поэтому безопасен в if/else без фигурных скобок.
+ */
+#define NEXUS_LOG_S(level) \
+    !(NEXUS_LOG_ENABLED(level) && ::nexus::logger::LoggerService::Instance() != nullptr) \
+        ? (void)0 \
+        : ::nexus::logger::LogStreamVoidify() & ::nexus::logger::LogStream(level)
+
+/**
+ * @def LOG_TRACE_S
+ * @brief Трассировочное сообщение, собираемое операторами <<
+ */
+#define LOG_TRACE_S NEXUS_LOG_S(::nexus::ipc::LOG_TRACE)
+
+/**
+ * @def LOG_DEBUG_S
+ * @brief Отладочное сообщение, собираемое операторами <<
+ */
+#define LOG_DEBUG_S NEXUS_LOG_S(::nexus::ipc::LOG_DEBUG)
+
+/**
+ * @def LOG_INFO_S
+ * @brief Информационное сообщение, собираемое операторами <<
+ *
+ * @example LOG_INFO_S << "item " << i << " took " << us << "us";
+ */
+#define LOG_INFO_S NEXUS_LOG_S(::nexus::ipc::LOG_INFO)
+
+/**
+ * @def LOG_WARN_S
+ * @brief Предупреждение, собираемое операторами <<
+ */
+#define LOG_WARN_S NEXUS_LOG_S(::nexus::ipc::LOG_WARN)
+
+/**
+ * @def LOG_ERROR_S
+ * @brief Сообщение об ошибке, собираемое операторами <<
+ */
+#define LOG_ERROR_S NEXUS_LOG_S(::nexus::ipc::LOG_ERROR)
+
+/**
+ * @def LOG_FATAL_S
+ * @brief Сообщение о фатальной ошибке, собираемое операторами << (выполнение не прерывается)
+ */
+#define LOG_FATAL_S NEXUS_LOG_S(::nexus::ipc::LOG_FATAL)
+
+/**
+ * @def NEXUS_LOG_SAMPLED(level, message, suppressed)
+ * @brief Отправка прореженной записи с числом подавленных записей в конце строки
+ *
+ * Запись уходит тем же путем, что и LOG_*, без ограничения длины LOG_*_S.
+ */
+#define NEXUS_LOG_SAMPLED(level, message, suppressed) \
+    do { \
+        if (auto* nexus_logger = ::nexus::logger::LoggerService::Instance()) { \
+            if ((suppressed) != 0) { \
+                std::string nexus_message(message); \
+                nexus_message += " ("; \
+                nexus_message += std::to_string(suppressed); \
+                nexus_message += " suppressed)"; \
+                nexus_logger->SendLog(level, nexus_message); \
+            } else { \
+                nexus_logger->SendLog(level, std::string(message)); \
+            } \
+        } \
+    } while(0)
+
+/**
+ * @def NEXUS_LOG_EVERY_N(level, n, message)
+ * @brief Вывод каждой N-й записи места вызова (1-й, N+1-й, ...)
+ *
+ * Состояние - статический атомарный счетчик места вызова, решение - один
+ * relaxed fetch_add; пропущенное сообщение не вычисляется. К выведенной
+ * строке добавляется " (N-1 suppressed)". Записи отключенного уровня не считаются.
+ */
+#define NEXUS_LOG_EVERY_N(level, n, message) \
+    do { \
+        static ::nexus::logger::EveryNSampler nexus_sampler; \
+        uint64_t nexus_suppressed = 0; \
+        if (NEXUS_LOG_ENABLED(level) && nexus_sampler.Sample((n), nexus_suppressed)) { \
+            NEXUS_LOG_SAMPLED(level, message, nexus_suppressed); \
+        } \
+    } while(0)
+
+/**
+ * @def NEXUS_LOG_EVERY_MS(level, ms, message)
+ * @brief Вывод не более одной записи места вызова за ms миллисекунд
+ *
+ * Время - грубые монотонные часы без системного вызова. Число подавленных
+ * за период записей добавляется к следующей выведенной строке.
+ */
+#define NEXUS_LOG_EVERY_MS(level, ms, message) \
+    do { \
+        static ::nexus::logger::IntervalSampler nexus_sampler; \
+        uint64_t nexus_suppressed = 0; \
+        if (NEXUS_LOG_ENABLED(level) && nexus_sampler.Sample((ms), nexus_suppressed)) { \
+            NEXUS_LOG_SAMPLED(level, message, nexus_suppressed); \
+        } \
+    } while(0)
+
+/**
+ * @def NEXUS_LOG_FIRST_N(level, n, message)
+ * @brief Вывод только первых N записей места вызова
+ */
+#define NEXUS_LOG_FIRST_N(level, n, message) \
+    do { \
+        static ::nexus::logger::FirstNSampler nexus_sampler; \
+        if (NEXUS_LOG_ENABLED(level) && nexus_sampler.Sample((n))) { \
+            NEXUS_LOG_SAMPLED(level, message, 0); \
+        } \
+    } while(0)
+
+/**
+ * @def LOG_TRACE_EVERY_N(n, message)
+ * @brief Трассировочное сообщение: каждая N-я запись места вызова
+ */
+#define LOG_TRACE_EVERY_N(n, message) NEXUS_LOG_EVERY_N(::nexus::ipc::LOG_TRACE, n, message)
+
+/**
+ * @def LOG_TRACE_EVERY_MS(ms, message)
+ * @brief Трассировочное сообщение: не чаще раза в ms миллисекунд для места вызова
+ */
+#define LOG_TRACE_EVERY_MS(ms, message) NEXUS_LOG_EVERY_MS(::nexus::ipc::LOG_TRACE, ms, message)
+
+/**
+ * @def LOG_TRACE_FIRST_N(n, message)
+ * @brief Трассировочное сообщение: только первые N записей места вызова
+ */
+#define LOG_TRACE_FIRST_N(n, message) NEXUS_LOG_FIRST_N(::nexus::ipc::LOG_TRACE, n, message)
+
+/**
+ * @def LOG_DEBUG_EVERY_N(n, message)
+ * @brief Отладочное сообщение: каждая N-я запись места вызова
+ */
+#define LOG_DEBUG_EVERY_N(n, message) NEXUS_LOG_EVERY_N(::nexus::ipc::LOG_DEBUG, n, message)
+
+/**
+ * @def LOG_DEBUG_EVERY_MS(ms, message)
+ * @brief Отладочное сообщение: не чаще раза в ms миллисекунд для места вызова
+ */
+#define LOG_DEBUG_EVERY_MS(ms, message) NEXUS_LOG_EVERY_MS(::nexus::ipc::LOG_DEBUG, ms, message)
+
+/**
+ * @def LOG_DEBUG_FIRST_N(n, message)
+ * @brief Отладочное сообщение: только первые N записей места вызова
+ */
+#define LOG_DEBUG_FIRST_N(n, message) NEXUS_LOG_FIRST_N(::nexus::ipc::LOG_DEBUG, n, message)
+
+/**
+ * @def LOG_INFO_EVERY_N(n, message)
+ * @brief Информационное сообщение: каждая N-я запись места вызова
+ *
+ * @example LOG_INFO_EVERY_N(1000, "Processed packet " + std::to_string(id));
+ */
+#define LOG_INFO_EVERY_N(n, message) NEXUS_LOG_EVERY_N(::nexus::ipc::LOG_INFO, n, message)
+
+/**
+ * @def LOG_INFO_EVERY_MS(ms, message)
+ * @brief Информационное сообщение: не чаще раза в ms миллисекунд для места вызова
+ */
+#define LOG_INFO_EVERY_MS(ms, message) NEXUS_LOG_EVERY_MS(::nexus::ipc::LOG_INFO, ms, message)
+
+/**
+ * @def LOG_INFO_FIRST_N(n, message)
+ * @brief Информационное сообщение: только первые N записей места вызова
+ */
+#define LOG_INFO_FIRST_N(n, message) NEXUS_LOG_FIRST_N(::nexus::ipc::LOG_INFO, n, message)
+
+/**
+ * @def LOG_WARN_EVERY_N(n, message)
+ * @brief Предупреждение: каждая N-я запись места вызова
+ */
+#define LOG_WARN_EVERY_N(n, message) NEXUS_LOG_EVERY_N(::nexus::ipc::LOG_WARN, n, message)
+
+/**
+ * @def LOG_WARN_EVERY_MS(ms, message)
+ * @brief Предупреждение: не чаще раза в ms миллисекунд для места вызова
+ */
+#define LOG_WARN_EVERY_MS(ms, message) NEXUS_LOG_EVERY_MS(::nexus::ipc::LOG_WARN, ms, message)
+
+/**
+ * @def LOG_WARN_FIRST_N(n, message)
+ * @brief Предупреждение: только первые N записей места вызова
+ */
+#define LOG_WARN_FIRST_N(n, message) NEXUS_LOG_FIRST_N(::nexus::ipc::LOG_WARN, n, message)
+
+/**
+ * @def LOG_ERROR_EVERY_N(n, message)
+ * @brief Сообщение об ошибке: каждая N-я запись места вызова
+ */
+#define LOG_ERROR_EVERY_N(n, message) NEXUS_LOG_EVERY_N(::nexus::ipc::LOG_ERROR, n, message)
+
+/**
+ * @def LOG_ERROR_EVERY_MS(ms, message)
+ * @brief Сообщение об ошибке: не чаще раза в ms миллисекунд для места вызова
+ */
+#define LOG_ERROR_EVERY_MS(ms, message) NEXUS_LOG_EVERY_MS(::nexus::ipc::LOG_ERROR, ms, message)
+
+/**
+ * @def LOG_ERROR_FIRST_N(n, message)
+ * @brief Сообщение об ошибке: только первые N записей места вызова
+ */
+#define LOG_ERROR_FIRST_N(n, message) NEXUS_LOG_FIRST_N(::nexus::ipc::LOG_ERROR, n, message)
+
+/**
+ * @def LOG_FATAL_EVERY_N(n, message)
+ * @brief Сообщение о фатальной ошибке: каждая N-я запись места вызова
+ */
+#define LOG_FATAL_EVERY_N(n, message) NEXUS_LOG_EVERY_N(::nexus::ipc::LOG_FATAL, n, message)
+
+/**
+ * @def LOG_FATAL_EVERY_MS(ms, message)
+ * @brief Сообщение о фатальной ошибке: не чаще раза в ms миллисекунд для места вызова
+ */
+#define LOG_FATAL_EVERY_MS(ms, message) NEXUS_LOG_EVERY_MS(::nexus::ipc::LOG_FATAL, ms, message)
+
+/**
+ * @def LOG_FATAL_FIRST_N(n, message)
+ * @brief Сообщение о фатальной ошибке: только первые N записей места вызова
+ */
+#define LOG_FATAL_FIRST_N(n, message) NEXUS_LOG_FIRST_N(::nexus::ipc::LOG_FATAL, n, message)
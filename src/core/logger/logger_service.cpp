@@ -1,16 +1,72 @@
 #include "logger_service.hpp"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 
+// POSIX
+#include <unistd.h>
+
 // Common
 #include "common/types/channels_names.hpp"
+#include "common/types/pulse_types.hpp"
+
+// Logger
+#include "format_registry.hpp"
+
+// Utils
+#include "common/utils/capture_clock.hpp"
+#include "common/utils/time_utils.hpp"
 
 namespace nexus::logger {
 std::unique_ptr<LoggerService> LoggerService::instance_ = nullptr;
 std::mutex LoggerService::mutex_;
+std::atomic<uint8_t> LoggerService::local_threshold_{ipc::SEVERITY_INFO};
+std::atomic<const std::atomic<uint8_t>*> LoggerService::threshold_{&local_threshold_};
+
+namespace {
+// Размер данных пакета LOG_BATCH: логгер дочитывает пакет одним чтением
+// независимо от размера, поэтому пакет ограничен лишь памятью фонового потока
+constexpr size_t kBatchCapacity = 32 * 1024;
+
+// Максимальный размер записи (заголовок + текст) внутри пакета LOG_BATCH
+constexpr size_t kMaxBatchRecord = kBatchCapacity - sizeof(ipc::BatchHeader);
+
+// Максимальная длина текста, принимаемая в кольцевой буфер потока
+constexpr size_t kMaxRecordText = kMaxBatchRecord - sizeof(ipc::RecordHeader);
+
+// Логгер доступен, но отклонил сообщение: повторная отправка не поможет
+bool IsRejected(const int error) {
+    return error == EPROTO || error == EBADMSG || error == EMSGSIZE;
+}
+} // namespace
+
+LoggerService::LoggerService(LoggerServiceConfig config)
+    : config_(std::move(config)), client_id_(static_cast<uint32_t>(getpid())) {
+}
 
 LoggerService::~LoggerService() {
-    utils::ipc::Disconnect(logger_coid_);
+    StopDrainer();
+    StopReconnector();
+
+    // Последняя попытка доставить записи, накопленные без соединения
+    if (spilling_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(spill_mutex_);
+        const int coid = ipc::Connect(channels::LOGGER);
+        if (coid != -1) {
+            Resume(coid);
+        }
+    }
+
+    ReportDropped(true);
+    utils::ipc::Disconnect(logger_coid_.load(std::memory_order_acquire));
+
+    // Порог логгера отображается вместе с сервисом - возвращаемся к локальному
+    if (initialized_) {
+        threshold_.store(&local_threshold_, std::memory_order_relaxed);
+    }
 }
 
 void LoggerService::Initialize(std::unique_ptr<LoggerService> logger) {
@@ -23,11 +79,25 @@ void LoggerService::Initialize(std::unique_ptr<LoggerService> logger) {
     instance_ = std::move(logger);
 
     if (instance_) {
+        instance_->initialized_ = true;
+
         try {
-            instance_->logger_coid_ = utils::ipc::ConnectToProcess(channels::LOGGER);
+            const int coid = utils::ipc::ConnectToProcess(channels::LOGGER);
+            instance_->logger_coid_.store(coid, std::memory_order_release);
+            instance_->SendRegistration(coid);
         } catch (const std::exception& e) {
-            instance_->logger_coid_ = -1;
             std::cerr << "Failed to connect to logger: " << e.what() << std::endl;
+            // Подключение продолжает фоновый поток, записи до него накапливаются
+            instance_->Disconnected(-1);
+        }
+
+        {
+            std::lock_guard<std::mutex> spill_lock(instance_->spill_mutex_);
+            instance_->AttachShared(true);
+        }
+
+        if (instance_->config_.mode == DeliveryMode::ASYNC) {
+            instance_->StartDrainer();
         }
     }
 }
@@ -37,40 +107,658 @@ LoggerService* LoggerService::Instance() noexcept {
 }
 
 bool LoggerService::IsConnected() const {
-    return logger_coid_ != -1;
+    return logger_coid_.load(std::memory_order_acquire) != -1
+           && !spilling_.load(std::memory_order_acquire);
 }
 
-void LoggerService::Reconnect() const {
-    if (logger_coid_ != -1) {
-        utils::ipc::Disconnect(logger_coid_);
+void LoggerService::Reconnect() {
+    Disconnected(logger_coid_.load(std::memory_order_acquire));
+}
+
+void LoggerService::AttachShared(const bool report_errors) {
+    try {
+        shared_levels_.push_back(ipc::SharedLevel::Open(channels::LOGGER));
+        threshold_.store(&shared_levels_.back()->Threshold(), std::memory_order_relaxed);
+    } catch (const std::exception& e) {
+        if (report_errors) {
+            std::cerr << "Shared log level is unavailable, using local threshold: "
+                      << e.what() << std::endl;
+        }
+    }
+
+    if (config_.mode != DeliveryMode::SHARED_MEMORY) {
+        return;
     }
 
     try {
-        logger_coid_ = utils::ipc::ConnectToProcess(channels::LOGGER);
+        shared_rings_.push_back(ipc::SharedRing::Open(channels::LOGGER));
+        shared_ring_.store(shared_rings_.back().get(), std::memory_order_release);
     } catch (const std::exception& e) {
-        logger_coid_ = -1;
+        // Буфер прежнего логгера никто не читает - дальше только канал
+        shared_ring_.store(nullptr, std::memory_order_release);
+        if (report_errors) {
+            std::cerr << "Shared ring is unavailable, falling back to channel: "
+                      << e.what() << std::endl;
+        }
     }
 }
 
-void LoggerService::SendInfo(const std::string& message) {
-    if (!IsConnected()) {
-        Reconnect();
+template <typename Spill>
+void LoggerService::SendOrSpill(const ipc::MessageCode code,
+                                const std::initializer_list<ipc::MessagePart> parts,
+                                const uint64_t timestamp, Spill&& spill) {
+    for (;;) {
+        if (!spilling_.load(std::memory_order_acquire)) {
+            const int coid = logger_coid_.load(std::memory_order_acquire);
+            if (utils::ipc::SendMessageV(coid, code, parts, timestamp)) {
+                return;
+            }
+            if (coid != -1 && IsRejected(errno)) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            Disconnected(coid);
+            continue;
+        }
+
+        // Проверка под блокировкой: переподключение могло завершиться после загрузки флага
+        std::lock_guard<std::mutex> lock(spill_mutex_);
+        if (spilling_.load(std::memory_order_relaxed)) {
+            spill();
+            return;
+        }
+    }
+}
+
+bool LoggerService::SpillRecord(ipc::RecordHeader header, const std::string_view text) {
+    if (spill_.empty()) {
+        spill_.resize(std::min(config_.spill_capacity, ipc::kMaxPayloadSize));
+    }
+
+    const size_t length = std::min<size_t>(text.size(), UINT16_MAX);
+    const size_t record_size = sizeof(header) + length;
+    if (spill_records_ == UINT16_MAX || spill_size_ + record_size > spill_.size()) {
+        return false;
+    }
+
+    // Время создания сохраняется, чтобы запись попала в лог со своим временем, а не
+    // со временем переподключения
+    if (header.timestamp == 0) {
+        header.timestamp = utils::time::CaptureTicks();
+    }
+    header.length = static_cast<uint16_t>(length);
+
+    char* out = spill_.data() + spill_size_;
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + sizeof(header), text.data(), length);
+
+    spill_size_ += record_size;
+    ++spill_records_;
+    return true;
+}
+
+void LoggerService::SpillBatch(const size_t batch_size) {
+    size_t offset = sizeof(ipc::BatchHeader);
+    while (offset + sizeof(ipc::RecordHeader) <= batch_size) {
+        ipc::RecordHeader header{};
+        std::memcpy(&header, batch_.data() + offset, sizeof(header));
+        offset += sizeof(header);
+
+        if (!SpillRecord(header, {batch_.data() + offset, header.length})) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+        offset += header.length;
     }
+}
 
-    utils::ipc::SendMessage(logger_coid_, ipc::LOG_INFO,
-                            this->name_ + ' ' + message);
+void LoggerService::Disconnected(const int coid) {
+    {
+        std::lock_guard<std::mutex> lock(spill_mutex_);
+        if (spilling_.load(std::memory_order_relaxed)
+            || logger_coid_.load(std::memory_order_relaxed) != coid) {
+            return;
+        }
+
+        spilling_.store(true, std::memory_order_release);
+        if (!reconnect_stop_ && !reconnector_.joinable()) {
+            reconnector_ = std::thread(&LoggerService::ReconnectLoop, this);
+        }
+    }
+    reconnect_cv_.notify_one();
+}
+
+void LoggerService::ReconnectLoop() {
+    std::unique_lock<std::mutex> lock(spill_mutex_);
+    auto delay = config_.reconnect_delay;
+
+    while (!reconnect_stop_) {
+        if (!spilling_.load(std::memory_order_relaxed)) {
+            delay = config_.reconnect_delay;
+            reconnect_cv_.wait(lock, [this] {
+                return reconnect_stop_ || spilling_.load(std::memory_order_relaxed);
+            });
+            continue;
+        }
+
+        // Подключение без блокировки: записи тем временем продолжают накапливаться
+        lock.unlock();
+        const int coid = ipc::Connect(channels::LOGGER);
+        lock.lock();
+
+        if (coid != -1 && Resume(coid)) {
+            continue;
+        }
+
+        reconnect_cv_.wait_for(lock, delay, [this] { return reconnect_stop_; });
+        delay = std::min(delay * 2, config_.reconnect_max_delay);
+    }
+}
+
+bool LoggerService::Resume(const int coid) {
+    utils::ipc::Disconnect(logger_coid_.exchange(coid, std::memory_order_acq_rel));
+
+    // Новый экземпляр логгера не знает ни имени, ни форматов клиента
+    if (!SendRegistration(coid)) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> formats_lock(formats_mutex_);
+        registered_formats_.store(0, std::memory_order_release);
+        if (!SendFormats(coid)) {
+            return false;
+        }
+    }
+
+    if (spill_records_ > 0) {
+        const ipc::BatchHeader batch_header{spill_records_};
+        std::memcpy(spill_.data(), &batch_header, sizeof(batch_header));
+
+        if (!utils::ipc::SendMessageV(coid, ipc::LOG_BATCH, {{spill_.data(), spill_size_}})) {
+            if (!IsRejected(errno)) {
+                return false;
+            }
+            dropped_.fetch_add(spill_records_, std::memory_order_relaxed);
+        }
+        spill_size_ = sizeof(ipc::BatchHeader);
+        spill_records_ = 0;
+    }
+
+    if (initialized_) {
+        AttachShared(false);
+    }
+    spilling_.store(false, std::memory_order_release);
+    return true;
+}
+
+void LoggerService::StopReconnector() {
+    {
+        std::lock_guard<std::mutex> lock(spill_mutex_);
+        reconnect_stop_ = true;
+    }
+    reconnect_cv_.notify_one();
+
+    if (reconnector_.joinable()) {
+        reconnector_.join();
+    }
+}
+
+void LoggerService::SendInfo(const std::string& message) {
+    Send(ipc::LOG_INFO, message);
 }
 
 void LoggerService::SendError(const std::string& message) {
-    if (!IsConnected()) {
-        Reconnect();
+    Send(ipc::LOG_ERROR, message);
+}
+
+void LoggerService::SendLog(const ipc::MessageCode level, const std::string_view message) {
+    Send(level, message);
+}
+
+int LoggerService::RequestConnection() const {
+    int coid = logger_coid_.load(std::memory_order_acquire);
+    if (coid != -1 || spilling_.load(std::memory_order_acquire)) {
+        return coid;
+    }
+
+    const int connected = ipc::Connect(channels::LOGGER);
+    if (connected == -1) {
+        return -1;
     }
+    if (!logger_coid_.compare_exchange_strong(coid, connected, std::memory_order_acq_rel)) {
+        utils::ipc::Disconnect(connected);
+        return coid;
+    }
+    SendRegistration(connected);
+    return connected;
+}
+
+bool LoggerService::RequestLogLevel(const ipc::Severity severity) const {
+    return utils::ipc::SendPulse(RequestConnection(), ipc::CurrentPriority(),
+                                 ipc::PULSE_SET_LEVEL, severity);
+}
 
-    utils::ipc::SendMessage(logger_coid_, ipc::LOG_ERROR,
-                            this->name_ + ' ' + message);
+bool LoggerService::QueryStats(ipc::LoggerStatsSnapshot& snapshot) const {
+    const int status = utils::ipc::SendRequest(RequestConnection(), ipc::STATS_QUERY, &snapshot,
+                                               sizeof(snapshot));
+    return status == static_cast<int>(sizeof(snapshot))
+           && snapshot.version == ipc::kStatsVersion;
 }
 
 void LoggerService::SetLogName(const std::string& name) {
-    name_ = name;
+    {
+        std::lock_guard<std::mutex> lock(name_mutex_);
+        name_ = name;
+    }
+
+    // Без соединения имя зарегистрирует переподключение
+    if (!spilling_.load(std::memory_order_acquire)) {
+        SendRegistration(logger_coid_.load(std::memory_order_acquire));
+    }
+}
+
+bool LoggerService::SendRegistration(const int coid) const {
+    std::string name;
+    {
+        std::lock_guard<std::mutex> lock(name_mutex_);
+        name = name_;
+    }
+    return utils::ipc::SendMessageV(coid, ipc::LOG_REGISTER, {{name.data(), name.size()}});
+}
+
+void LoggerService::Send(const ipc::MessageCode code, const std::string_view message) {
+    // Метка снимается до любых ожиданий: время записи - момент вызова, а не доставки
+    const uint64_t timestamp = utils::time::CaptureTicks();
+
+    if (config_.mode == DeliveryMode::ASYNC) {
+        Enqueue(code, message, timestamp);
+        return;
+    }
+
+    if (dropped_.load(std::memory_order_relaxed) != 0) {
+        ReportDropped(false);
+    }
+
+    // Без соединения разделяемый буфер не используется: записи сохраняются до подключения
+    ipc::SharedRing* const ring = shared_ring_.load(std::memory_order_acquire);
+    if (ring != nullptr && !spilling_.load(std::memory_order_acquire)
+        && PublishShared(*ring, code, message, timestamp)) {
+        return;
+    }
+
+    // Имя клиента не передается: логгер знает его по процессу отправителя
+    SendOrSpill(code, {{message.data(), message.size()}}, timestamp, [&] {
+        const auto thread_id = static_cast<uint32_t>(ipc::CurrentThreadId());
+        if (!SpillRecord({code, thread_id, spill_records_, timestamp, 0}, message)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+}
+
+void LoggerService::SendEncoded(const uint32_t format_id, const std::string_view record) {
+    const uint64_t timestamp = utils::time::CaptureTicks();
+    RegisterFormats(format_id);
+
+    if (config_.mode == DeliveryMode::ASYNC) {
+        Enqueue(ipc::LOG_FORMATTED, record, timestamp);
+        return;
+    }
+
+    if (dropped_.load(std::memory_order_relaxed) != 0) {
+        ReportDropped(false);
+    }
+
+    ipc::SharedRing* const ring = shared_ring_.load(std::memory_order_acquire);
+    if (ring != nullptr && !spilling_.load(std::memory_order_acquire)
+        && PublishShared(*ring, ipc::LOG_FORMATTED, record, timestamp)) {
+        return;
+    }
+
+    SendOrSpill(ipc::LOG_FORMATTED, {{record.data(), record.size()}}, timestamp, [&] {
+        const auto thread_id = static_cast<uint32_t>(ipc::CurrentThreadId());
+        if (!SpillRecord({ipc::LOG_FORMATTED, thread_id, spill_records_, timestamp, 0},
+                         record)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+}
+
+void LoggerService::RegisterFormats(const uint32_t format_id) {
+    if (format_id < registered_formats_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    int coid = -1;
+    {
+        std::lock_guard<std::mutex> lock(formats_mutex_);
+
+        // Без соединения форматы регистрирует переподключение, до отправки накопленных записей
+        if (spilling_.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        coid = logger_coid_.load(std::memory_order_acquire);
+        if (SendFormats(coid)) {
+            return;
+        }
+    }
+
+    // Вне formats_mutex_: переподключение захватывает его под spill_mutex_
+    Disconnected(coid);
+}
+
+bool LoggerService::SendFormats(const int coid) {
+    const auto count = static_cast<uint32_t>(FormatRegistry::Size());
+    uint32_t next = registered_formats_.load(std::memory_order_acquire);
+    for (; next < count; ++next) {
+        const ipc::FormatRegistration registration{client_id_, next};
+        const char* format = FormatRegistry::Get(next);
+        const bool sent = utils::ipc::SendMessageV(coid, ipc::LOG_FORMAT, {
+            {&registration, sizeof(registration)},
+            {format, std::strlen(format)}
+        });
+        if (!sent) {
+            break;
+        }
+    }
+    registered_formats_.store(next, std::memory_order_release);
+    return next == count;
+}
+
+bool LoggerService::PublishShared(ipc::SharedRing& ring, const ipc::MessageCode code,
+                                  const std::string_view message, const uint64_t timestamp) {
+    const auto thread_id = static_cast<uint32_t>(ipc::CurrentThreadId());
+    const auto result = ring.TryPush(code, client_id_, thread_id, timestamp, message.data(),
+                                     message.size());
+    switch (result) {
+        case ipc::SharedRing::PushResult::PUSHED:
+            return true;
+        case ipc::SharedRing::PushResult::PUSHED_WAKE:
+            // Буфер был пуст и логгер ждет в MsgReceive - звоним в канал
+            if (const int coid = logger_coid_.load(std::memory_order_acquire);
+                !utils::ipc::SendPulse(coid, ipc::CurrentPriority(), ipc::PULSE_RING_DOORBELL)) {
+                // Логгер недоступен и буфер уже не прочтет - запись уходит через канал
+                // или сохраняется до переподключения
+                Disconnected(coid);
+                return false;
+            }
+            return true;
+        case ipc::SharedRing::PushResult::FULL:
+            if (DropOnOverload(code, message)) {
+                return true;
+            }
+            // Запись не отбрасывается - отправляем через канал, логгер вычитает
+            // буфер перед обработкой такого сообщения
+            return false;
+        default:
+            // Сообщение больше слота - отправляем через канал
+            return false;
+    }
+}
+
+void LoggerService::Enqueue(const ipc::MessageCode code, const std::string_view message,
+                            const uint64_t timestamp) {
+    ThreadRing& thread_ring = GetThreadRing();
+
+    const size_t max_text = std::min(
+        kMaxRecordText, thread_ring.ring.MaxRecordSize() - sizeof(ipc::RecordHeader)
+    );
+    if (message.size() > max_text) {
+        // Длинная запись (например, дамп стека) не обрезается, а уходит через канал
+        // после уже поставленных в буфер записей потока
+        FlushThreadRing(thread_ring);
+        SendOrSpill(code, {{message.data(), message.size()}}, timestamp, [&] {
+            if (!SpillRecord({code, thread_ring.thread_id, spill_records_, timestamp, 0},
+                             message)) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        return;
+    }
+    const size_t length = message.size();
+
+    void* slot = thread_ring.ring.BeginWrite(sizeof(ipc::RecordHeader) + length);
+    while (slot == nullptr) {
+        if (DropOnOverload(code, message)) {
+            return;
+        }
+        // Буфер заполнен - ждем, пока фоновый поток его разгрузит
+        std::this_thread::yield();
+        slot = thread_ring.ring.BeginWrite(sizeof(ipc::RecordHeader) + length);
+    }
+
+    const ipc::RecordHeader header{
+        code, thread_ring.thread_id, thread_ring.next_sequence++, timestamp,
+        static_cast<uint16_t>(length)
+    };
+    auto* data = static_cast<char*>(slot);
+    std::memcpy(data, &header, sizeof(header));
+    std::memcpy(data + sizeof(header), message.data(), length);
+
+    thread_ring.ring.EndWrite();
+}
+
+void LoggerService::FlushThreadRing(const ThreadRing& thread_ring) {
+    std::unique_lock<std::mutex> lock(drainer_mutex_);
+    while (!thread_ring.ring.Empty() && !drainer_stop_.load(std::memory_order_acquire)) {
+        drain_requested_ = true;
+        drainer_cv_.notify_one();
+        drained_cv_.wait(lock);
+    }
+
+    // Пустой буфер еще не значит, что записи отправлены: они могут ждать в пакете
+    // текущего прохода. Завершение следующего по счету прохода это гарантирует
+    const uint64_t pass = drain_passes_;
+    drain_requested_ = true;
+    drainer_cv_.notify_one();
+    drained_cv_.wait(lock, [this, pass] {
+        return drain_passes_ != pass || drainer_stop_.load(std::memory_order_acquire);
+    });
+}
+
+LoggerService::ThreadRing& LoggerService::GetThreadRing() {
+    // Привязка буфера к потоку: при завершении потока буфер помечается закрытым
+    // и удаляется фоновым потоком после отправки оставшихся записей
+    struct Handle {
+        ~Handle() {
+            if (ring) {
+                ring->closed.store(true, std::memory_order_release);
+            }
+        }
+
+        const LoggerService* owner{nullptr};
+        std::shared_ptr<ThreadRing> ring;
+    };
+    thread_local Handle handle;
+
+    if (handle.owner != this) {
+        if (handle.ring) {
+            handle.ring->closed.store(true, std::memory_order_release);
+        }
+
+        handle.ring = std::make_shared<ThreadRing>(
+            config_.ring_capacity, static_cast<uint32_t>(ipc::CurrentThreadId())
+        );
+        handle.owner = this;
+
+        {
+            std::lock_guard<std::mutex> lock(rings_mutex_);
+            pending_rings_.push_back(handle.ring);
+            rings_changed_.store(true, std::memory_order_release);
+        }
+
+        // Экземпляр, не переданный в Initialize(), запускает фоновый поток при первой
+        // записи: иначе буфер не разгружается и BLOCK ждет места бесконечно
+        StartDrainer();
+    }
+
+    return *handle.ring;
+}
+
+void LoggerService::StartDrainer() {
+    std::call_once(drainer_started_, [this] {
+        batch_.resize(kBatchCapacity);
+        drainer_stop_.store(false, std::memory_order_release);
+        drainer_ = std::thread(&LoggerService::DrainLoop, this);
+    });
+}
+
+void LoggerService::StopDrainer() {
+    if (!drainer_.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(drainer_mutex_);
+        drainer_stop_.store(true, std::memory_order_release);
+    }
+    drainer_cv_.notify_one();
+    drainer_.join();
+}
+
+bool LoggerService::DropOnOverload(const ipc::MessageCode code, const std::string_view message) {
+    const OverloadPolicy policy = config_.overload_policy;
+    if (policy == OverloadPolicy::BLOCK
+        || (policy == OverloadPolicy::DROP_BELOW_ERROR
+            && ipc::SeverityOfRecord(code, message) >= ipc::SEVERITY_ERROR)) {
+        return false;
+    }
+
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void LoggerService::ReportDropped(const bool force) {
+    const uint64_t now = utils::time::ToNanoseconds(utils::time::GetMonotonicTime());
+    uint64_t last = last_drop_report_ns_.load(std::memory_order_relaxed);
+    const auto interval = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(config_.drop_report_interval).count()
+    );
+
+    // Отчет отправляет один поток за период
+    if (!force && (now - last < interval
+                   || !last_drop_report_ns_.compare_exchange_strong(last, now))) {
+        return;
+    }
+    if (force) {
+        last_drop_report_ns_.store(now, std::memory_order_relaxed);
+    }
+
+    // Без соединения счетчик копится: отчет уйдет после накопленных записей
+    if (spilling_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    const uint64_t dropped = dropped_.exchange(0, std::memory_order_relaxed);
+    if (dropped == 0) {
+        return;
+    }
+
+    char text[64];
+    const int length = snprintf(text, sizeof(text), "%llu messages dropped (client buffer full)",
+                                static_cast<unsigned long long>(dropped));
+
+    // Уровень ERROR: отчет не должна отбросить политика DROP_BELOW_ERROR логгера
+    const int coid = logger_coid_.load(std::memory_order_acquire);
+    const bool sent = utils::ipc::SendMessageV(coid, ipc::LOG_ERROR,
+                                               {{text, static_cast<size_t>(length)}});
+    if (!sent) {
+        dropped_.fetch_add(dropped, std::memory_order_relaxed);
+        Disconnected(coid);
+    }
+}
+
+void LoggerService::DrainLoop() {
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+
+    while (!drainer_stop_.load(std::memory_order_acquire)) {
+        if (dropped_.load(std::memory_order_relaxed) != 0) {
+            ReportDropped(false);
+        }
+
+        const bool drained = DrainOnce(rings);
+
+        std::unique_lock<std::mutex> lock(drainer_mutex_);
+        ++drain_passes_;
+        drained_cv_.notify_all();
+        if (!drained) {
+            drainer_cv_.wait_for(lock, config_.drain_interval, [this] {
+                return drain_requested_ || drainer_stop_.load(std::memory_order_acquire);
+            });
+        }
+        drain_requested_ = false;
+    }
+
+    // Финальный проход: отправляем все, что потоки успели записать до остановки
+    DrainOnce(rings);
+
+    std::lock_guard<std::mutex> lock(drainer_mutex_);
+    ++drain_passes_;
+    drained_cv_.notify_all();
+}
+
+bool LoggerService::DrainOnce(std::vector<std::shared_ptr<ThreadRing>>& rings) {
+    if (rings_changed_.exchange(false, std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings.insert(rings.end(), pending_rings_.begin(), pending_rings_.end());
+        pending_rings_.clear();
+    }
+
+    std::vector<char>& batch = batch_;
+    size_t batch_size = sizeof(ipc::BatchHeader);
+    uint16_t record_count = 0;
+    bool drained = false;
+
+    for (const auto& thread_ring : rings) {
+        size_t size = 0;
+        while (const void* data = thread_ring->ring.BeginRead(size)) {
+            ipc::RecordHeader header{};
+            std::memcpy(&header, data, sizeof(header));
+            const char* text = static_cast<const char*>(data) + sizeof(header);
+
+            // Запись копируется как есть: имя клиента логгер знает из регистрации
+            const size_t record_size = sizeof(header) + header.length;
+            if (batch_size + record_size > batch.size()) {
+                SendBatch(batch_size, record_count);
+            }
+
+            char* out = batch.data() + batch_size;
+            std::memcpy(out, &header, sizeof(header));
+            std::memcpy(out + sizeof(header), text, header.length);
+
+            batch_size += record_size;
+            ++record_count;
+            drained = true;
+
+            thread_ring->ring.EndRead();
+        }
+    }
+
+    if (record_count > 0) {
+        SendBatch(batch_size, record_count);
+    }
+
+    // Удаляем буферы завершившихся потоков, из которых все отправлено
+    rings.erase(
+        std::remove_if(rings.begin(), rings.end(),
+                       [](const std::shared_ptr<ThreadRing>& thread_ring) {
+                           return thread_ring->closed.load(std::memory_order_acquire)
+                                  && thread_ring->ring.Empty();
+                       }),
+        rings.end()
+    );
+
+    return drained;
+}
+
+void LoggerService::SendBatch(size_t& batch_size, uint16_t& record_count) {
+    const ipc::BatchHeader batch_header{record_count};
+    std::memcpy(batch_.data(), &batch_header, sizeof(batch_header));
+
+    // Метки несут записи пакета
+    SendOrSpill(ipc::LOG_BATCH, {{batch_.data(), batch_size}}, 0,
+                [&] { SpillBatch(batch_size); });
+
+    batch_size = sizeof(ipc::BatchHeader);
+    record_count = 0;
 }
 }
\ No newline at end of file
@@ -5,16 +5,95 @@
  * @brief Фасад для клиентского использования системы логирования
  */
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// IPC
+#include "../ipc/shared_level.hpp"
+#include "../ipc/shared_ring.hpp"
+
+// Logger
+#include "format_writer.hpp"
+#include "overload_policy.hpp"
+
+// Types
+#include "../../common/types/stats_types.hpp"
 
 // Utils
 #include "../../common/utils/ipc_utils.hpp"
+#include "../../common/utils/spsc_ring.hpp"
 
 namespace nexus::logger {
+
+/**
+ * @brief Режим доставки сообщений логгеру
+ */
+enum class DeliveryMode {
+    SYNC,         ///< Каждое сообщение отправляется блокирующим MsgSend из вызывающего потока
+    ASYNC,        ///< Сообщения пишутся в кольцевой буфер потока и отправляются пакетами
+    SHARED_MEMORY ///< Сообщения публикуются в разделяемый буфер логгера, канал - только звонок
+};
+
+/**
+ * @brief Параметры клиентского сервиса логирования
+ */
+struct LoggerServiceConfig {
+    /// @brief Режим доставки сообщений
+    DeliveryMode mode{DeliveryMode::SYNC};
+
+    /// @brief Размер кольцевого буфера каждого потока в байтах (ASYNC)
+    size_t ring_capacity{64 * 1024};
+
+    /// @brief Период опроса буферов фоновым потоком при отсутствии данных (ASYNC)
+    std::chrono::milliseconds drain_interval{1};
+
+    /**
+     * @brief Поведение при заполненном буфере клиента (ASYNC, SHARED_MEMORY)
+     *
+     * Запись в буфер освобождает место только у читателя, поэтому DROP_OLDEST
+     * на стороне клиента отбрасывает новую запись, как DROP_NEWEST. При
+     * DROP_BELOW_ERROR записи ERROR и FATAL ждут места (ASYNC) или уходят
+     * через канал (SHARED_MEMORY). В режиме SYNC буфера клиента нет - действует
+     * политика очереди логгера.
+     */
+    OverloadPolicy overload_policy{OverloadPolicy::BLOCK};
+
+    /// @brief Минимальный период между строками "N messages dropped" клиента
+    std::chrono::milliseconds drop_report_interval{1000};
+
+    /// @brief Пауза перед повторным подключением к логгеру, удваивается после каждой неудачи
+    std::chrono::milliseconds reconnect_delay{10};
+
+    /// @brief Наибольшая пауза между попытками подключения
+    std::chrono::milliseconds reconnect_max_delay{1000};
+
+    /**
+     * @brief Размер буфера записей, накопленных без соединения с логгером (0 - не накапливать)
+     *
+     * Пока логгер недоступен, записи сохраняются в буфер вместе со временем
+     * создания и после подключения отправляются одним пакетом LOG_BATCH раньше
+     * любых новых записей. Не поместившиеся записи отбрасываются и попадают в
+     * строку "N messages dropped". Ограничен kMaxPayloadSize, текст одной записи
+     * в буфере - 64 КиБ.
+     */
+    size_t spill_capacity{256 * 1024};
+};
+
 class LoggerService final {
 public:
+    /**
+     * @brief Конструктор
+     * @param config Параметры доставки сообщений
+     */
+    explicit LoggerService(LoggerServiceConfig config = {});
+
     virtual ~LoggerService();
 
     /**
@@ -29,16 +108,33 @@ public:
      */
     static LoggerService* Instance() noexcept;
 
+    /**
+     * @brief Проверка уровня по текущему порогу
+     * @param severity Уровень сообщения
+     *
+     * Порог публикует логгер в разделяемой памяти (см. ipc::SharedLevel), до подключения
+     * действует локальный порог SEVERITY_INFO. Проверка - две relaxed-загрузки
+     * (указатель на порог и сам порог) без обращений к ядру, поэтому макросы
+     * выполняют ее до вычисления аргументов.
+     */
+    static bool IsEnabled(const ipc::Severity severity) noexcept {
+        return severity >= threshold_.load(std::memory_order_relaxed)
+                                     ->load(std::memory_order_relaxed);
+    }
+
     /**
     * @brief Проверка соединения с логгером
-    * @return Результат проверки соединения
+    * @return false, если соединения нет и записи накапливаются до подключения
     */
     bool IsConnected() const;
 
     /**
     * @brief Переподключиться к каналу логгера
+    *
+    * Соединение восстанавливает фоновый поток с нарастающей паузой между
+    * попытками, до подключения записи накапливаются в буфере (spill_capacity).
     */
-    void Reconnect() const;
+    void Reconnect();
 
     /**
      * @brief Отправить информационное сообщение
@@ -52,6 +148,51 @@ public:
      */
     virtual void SendError(const std::string& message);
 
+    /**
+     * @brief Отправить сообщение заданного уровня
+     * @param level Код уровня (LOG_TRACE ... LOG_FATAL)
+     * @param message Текст сообщения
+     */
+    virtual void SendLog(ipc::MessageCode level, std::string_view message);
+
+    /**
+     * @brief Запросить у логгера смену порога уровня для всех клиентов
+     * @param severity Новый порог
+     * @return false, если пульс не удалось отправить
+     *
+     * Логгер обновляет порог в разделяемой памяти, новое значение сразу
+     * действует во всех подключенных процессах.
+     */
+    bool RequestLogLevel(ipc::Severity severity) const;
+
+    /**
+     * @brief Запросить у логгера снимок его метрик
+     * @param snapshot [out] Метрики логгера
+     * @return false, если логгер недоступен или версия снимка не совпадает
+     *
+     * Позволяет приложению заметить, что логгер не успевает (растет очередь
+     * и задержка ответа), до того как начнут блокироваться клиенты.
+     */
+    bool QueryStats(ipc::LoggerStatsSnapshot& snapshot) const;
+
+    /**
+     * @brief Отправить запись с отложенным форматированием
+     * @param level Уровень записи (LOG_INFO или LOG_ERROR)
+     * @param format_id Номер формата из FormatRegistry
+     * @param args Аргументы подстановок "{}"
+     *
+     * Передаются только номер формата и аргументы в двоичном виде, текст
+     * собирает логгер в потоке записи. Еще не переданные логгеру форматы
+     * регистрируются перед отправкой записи.
+     */
+    template <typename... Args>
+    void SendFormatted(const ipc::MessageCode level, const uint32_t format_id,
+                       const Args&... args) {
+        FormatWriter writer(level, client_id_, format_id);
+        (writer.Append(args), ...);
+        SendEncoded(format_id, writer.View());
+    }
+
     /**
      * @brief Установить имя логгера
      * @param name Имя для идентификации в логах
@@ -59,10 +200,259 @@ public:
     void SetLogName(const std::string& name);
 
 private:
+    /**
+     * @brief Отправка сообщения выбранным способом доставки
+     * @param code Код сообщения
+     * @param message Текст сообщения
+     */
+    void Send(ipc::MessageCode code, std::string_view message);
+
+    /**
+     * @brief Отправка готовой записи LOG_FORMATTED выбранным способом доставки
+     * @param format_id Номер формата записи
+     * @param record Заголовок и аргументы записи
+     */
+    void SendEncoded(uint32_t format_id, std::string_view record);
+
+    /**
+     * @brief Отправка сообщения через канал или сохранение до подключения к логгеру
+     * @param code Код сообщения
+     * @param parts Части данных сообщения
+     * @param timestamp Метка CaptureTicks() создания сообщения
+     * @param spill Сохранение записей сообщения в буфер, вызывается под spill_mutex_
+     *
+     * Сообщение, отклоненное логгером (ошибка протокола), отбрасывается:
+     * повторная отправка после переподключения не поможет.
+     */
+    template <typename Spill>
+    void SendOrSpill(ipc::MessageCode code, std::initializer_list<ipc::MessagePart> parts,
+                     uint64_t timestamp, Spill&& spill);
+
+    /**
+     * @brief Копирование записи в буфер недоставленных записей (под spill_mutex_)
+     * @param header Заголовок записи, нулевая метка заменяется текущей
+     * @param text Текст записи
+     * @return false, если запись не поместилась
+     */
+    bool SpillRecord(ipc::RecordHeader header, std::string_view text);
+
+    /// @brief Копирование записей пакета LOG_BATCH в буфер недоставленных записей
+    void SpillBatch(size_t batch_size);
+
+    /**
+     * @brief Учет разрыва соединения coid и запуск фонового переподключения
+     *
+     * Повторные вызовы с уже замененным соединением ничего не делают.
+     */
+    void Disconnected(int coid);
+
+    /// @brief Цикл фонового потока, восстанавливающего соединение с логгером
+    void ReconnectLoop();
+
+    /**
+     * @brief Переход на новое соединение (под spill_mutex_)
+     * @return false, если регистрацию или накопленные записи не удалось отправить
+     *
+     * Регистрирует имя и форматы клиента, отправляет накопленные записи и заново
+     * отображает сегменты нового экземпляра логгера.
+     */
+    bool Resume(int coid);
+
+    void StopReconnector();
+
+    /**
+     * @brief Отображение порога и разделяемого буфера логгера
+     * @param report_errors Сообщать в stderr о недоступных сегментах
+     *
+     * Перезапущенный логгер создает сегменты заново, поэтому после
+     * переподключения они отображаются повторно. Прежние отображения остаются
+     * до удаления сервиса: к ним могут обращаться другие потоки.
+     */
+    void AttachShared(bool report_errors);
+
+    /**
+     * @brief Регистрация у логгера всех форматов до format_id включительно
+     *
+     * Форматы отправляются синхронно через канал, поэтому логгер получает их
+     * раньше любой записи, отправленной после возврата, в том числе через
+     * кольцевые и разделяемый буферы.
+     */
+    void RegisterFormats(uint32_t format_id);
+
+    /**
+     * @brief Регистрация имени клиента по соединению coid
+     *
+     * Логгер узнает отправителя записей по процессу из сведений транспорта,
+     * поэтому имя передается один раз, а не в каждой записи. Имя копируется
+     * под name_mutex_ и отправляется без блокировки.
+     */
+    bool SendRegistration(int coid) const;
+
+    /**
+     * @brief Соединение для запросов к логгеру
+     * @return Текущее соединение или -1
+     *
+     * Экземпляр, не переданный в Initialize(), подключается при первом запросе.
+     * Разорванное соединение восстанавливает фоновый поток, запрос его не ждет.
+     */
+    int RequestConnection() const;
+
+    /**
+     * @brief Отправка логгеру еще не зарегистрированных форматов (под formats_mutex_)
+     * @return false, если отправить удалось не все
+     */
+    bool SendFormats(int coid);
+
+    /**
+     * @brief Публикация сообщения в разделяемый буфер логгера (SHARED_MEMORY)
+     * @return false, если буфер заполнен или сообщение не помещается в слот
+     */
+    bool PublishShared(ipc::SharedRing& ring, ipc::MessageCode code, std::string_view message,
+                       uint64_t timestamp);
+
+    /**
+     * @brief Кольцевой буфер одного потока-производителя
+     */
+    struct ThreadRing {
+        ThreadRing(size_t capacity, uint32_t id) : ring(capacity), thread_id(id) {
+        }
+
+        utils::SpscRing ring;
+
+        /// @brief Поток-владелец (ipc::CurrentThreadId())
+        const uint32_t thread_id;
+        uint32_t next_sequence{0};
+
+        /// @brief Поток-владелец завершился, буфер удаляется после опустошения
+        std::atomic<bool> closed{false};
+    };
+
+    /**
+     * @brief Постановка сообщения в кольцевой буфер текущего потока (ASYNC)
+     *
+     * Сообщение длиннее записи буфера отправляется через канал целиком,
+     * после отправки всех записей, уже стоящих в буфере потока.
+     *
+     * @param code Код сообщения
+     * @param message Текст сообщения
+     * @param timestamp Метка CaptureTicks() вызова LOG_*
+     */
+    void Enqueue(ipc::MessageCode code, std::string_view message, uint64_t timestamp);
+
+    /**
+     * @brief Ожидание отправки всех записей буфера текущего потока
+     *
+     * Буфер разгружает только фоновый поток, поэтому вызывающий будит его
+     * и ждет прохода, завершившегося после опустошения буфера.
+     */
+    void FlushThreadRing(const ThreadRing& thread_ring);
+
+    /**
+     * @brief Получить (при необходимости создать) буфер текущего потока
+     */
+    ThreadRing& GetThreadRing();
+
+    /// @brief Цикл фонового потока, упаковывающего записи в пакеты LOG_BATCH
+    void DrainLoop();
+
+    /**
+     * @brief Однократный проход по всем буферам с отправкой пакетов
+     * @return true, если была отправлена хотя бы одна запись
+     */
+    bool DrainOnce(std::vector<std::shared_ptr<ThreadRing>>& rings);
+
+    /// @brief Отправка накопленного пакета логгеру
+    void SendBatch(size_t& batch_size, uint16_t& record_count);
+
+    /// @brief Запуск фонового потока ASYNC; повторные вызовы ничего не делают
+    void StartDrainer();
+    void StopDrainer();
+
+    /**
+     * @brief Учет записи, не поместившейся в буфер, по политике переполнения
+     * @return true - запись отброшена, false - отправитель должен ждать места
+     */
+    bool DropOnOverload(ipc::MessageCode code, std::string_view message);
+
+    /**
+     * @brief Отправка логгеру строки с числом отброшенных клиентом записей
+     * @param force Отправить, не дожидаясь drop_report_interval
+     *
+     * Строка уходит через канал в обход буферов, поэтому попадает в лог
+     * после всех записей, опубликованных до нее.
+     */
+    void ReportDropped(bool force);
+
     static std::unique_ptr<LoggerService> instance_;
     static std::mutex mutex_;
 
-    mutable int logger_coid_{-1};
+    /// @brief Порог до подключения к логгеру или при недоступной разделяемой памяти
+    static std::atomic<uint8_t> local_threshold_;
+
+    /// @brief Действующий порог: локальный или опубликованный логгером
+    static std::atomic<const std::atomic<uint8_t>*> threshold_;
+
+    const LoggerServiceConfig config_;
+
+    /// @brief Экземпляр установлен Initialize() и публикует порог логгера в threshold_
+    bool initialized_{false};
+
+    /// @brief Соединение с логгером (-1 - нет соединения)
+    mutable std::atomic<int> logger_coid_{-1};
+
+    /// @brief Имя клиента: меняет SetLogName(), читают переподключение и RequestConnection()
+    mutable std::mutex name_mutex_;
     std::string name_;
+
+    /// @brief Идентификатор клиента в записях LOG_FORMATTED (pid процесса)
+    const uint32_t client_id_;
+
+    /// @brief Число форматов, уже зарегистрированных у логгера по текущему соединению
+    mutable std::atomic<uint32_t> registered_formats_{0};
+    std::mutex formats_mutex_;
+
+    /// @brief Разделяемый буфер логгера (SHARED_MEMORY, nullptr - недоступен)
+    std::atomic<ipc::SharedRing*> shared_ring_{nullptr};
+
+    /// @brief Отображения сегментов логгера: текущие и прежних экземпляров
+    std::vector<std::unique_ptr<ipc::SharedLevel>> shared_levels_;
+    std::vector<std::unique_ptr<ipc::SharedRing>> shared_rings_;
+
+    /// @brief Логгер недоступен: записи копируются в spill_ до переподключения
+    std::atomic<bool> spilling_{false};
+
+    /// @brief Защищает буфер недоставленных записей и смену соединения
+    std::mutex spill_mutex_;
+    std::condition_variable reconnect_cv_;
+    std::thread reconnector_;
+    bool reconnect_stop_{false};
+
+    /// @brief Пакет LOG_BATCH из накопленных записей, выделяется при первом разрыве
+    std::vector<char> spill_;
+    size_t spill_size_{sizeof(ipc::BatchHeader)};
+    uint16_t spill_records_{0};
+
+    /// @brief Буферы потоков, еще не подхваченные фоновым потоком
+    std::mutex rings_mutex_;
+    std::vector<std::shared_ptr<ThreadRing>> pending_rings_;
+    std::atomic<bool> rings_changed_{false};
+
+    std::once_flag drainer_started_;
+    std::thread drainer_;
+    std::mutex drainer_mutex_;
+    std::condition_variable drainer_cv_;
+    std::atomic<bool> drainer_stop_{false};
+
+    /// @brief Число завершенных проходов и запрос внеочередного прохода (под drainer_mutex_)
+    std::condition_variable drained_cv_;
+    uint64_t drain_passes_{0};
+    bool drain_requested_{false};
+
+    /// @brief Пакет LOG_BATCH, собираемый фоновым потоком
+    std::vector<char> batch_;
+
+    /// @brief Записи, отброшенные после последней отправленной строки отчета
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> last_drop_report_ns_{0};
 };
-} // namespace nexus::logger
\ No newline at end of file
+} // namespace nexus::logger
@@ -0,0 +1,154 @@
+#include "logger_stats.hpp"
+
+#include <cstdio>
+
+// Utils
+#include "../../common/utils/time_utils.hpp"
+
+namespace nexus::logger {
+
+namespace {
+std::atomic<uint64_t> next_stats_id{1};
+
+uint64_t Sum(const std::atomic<uint64_t>& counter) {
+    return counter.load(std::memory_order_relaxed);
+}
+
+void SumHistogram(const std::atomic<uint64_t> (&histogram)[ipc::kLatencyBucketCount],
+                  ipc::LatencyBuckets& total) {
+    for (size_t i = 0; i < ipc::kLatencyBucketCount; ++i) {
+        total.counts[i] += histogram[i].load(std::memory_order_relaxed);
+    }
+}
+
+// Длительность в удобных единицах: "512ns", "4.1us", "1.0ms", "2.1s"
+std::string FormatDuration(const uint64_t nanoseconds) {
+    char buffer[32];
+    if (nanoseconds < 1000) {
+        snprintf(buffer, sizeof(buffer), "%lluns", static_cast<unsigned long long>(nanoseconds));
+    } else if (nanoseconds < 1000000) {
+        snprintf(buffer, sizeof(buffer), "%.1fus", static_cast<double>(nanoseconds) / 1e3);
+    } else if (nanoseconds < 1000000000) {
+        snprintf(buffer, sizeof(buffer), "%.1fms", static_cast<double>(nanoseconds) / 1e6);
+    } else {
+        snprintf(buffer, sizeof(buffer), "%.1fs", static_cast<double>(nanoseconds) / 1e9);
+    }
+    return buffer;
+}
+
+// Скорость изменения счетчика в секунду между снимками
+double Rate(const uint64_t current, const uint64_t previous, const uint64_t elapsed_ns) {
+    if (elapsed_ns == 0 || current < previous) {
+        return 0.0;
+    }
+    return static_cast<double>(current - previous) * 1e9 / static_cast<double>(elapsed_ns);
+}
+
+// Гистограмма значений, учтенных между снимками
+ipc::LatencyBuckets Delta(const ipc::LatencyBuckets& current,
+                          const ipc::LatencyBuckets& previous) {
+    ipc::LatencyBuckets delta{};
+    for (size_t i = 0; i < ipc::kLatencyBucketCount; ++i) {
+        delta.counts[i] = current.counts[i] >= previous.counts[i]
+                              ? current.counts[i] - previous.counts[i]
+                              : current.counts[i];
+    }
+    return delta;
+}
+} // namespace
+
+LoggerStats::LoggerStats() : id_(next_stats_id.fetch_add(1, std::memory_order_relaxed)) {
+}
+
+LoggerStats::ThreadCounters& LoggerStats::Local() {
+    // Привязка по номеру экземпляра, а не по адресу: новый логгер может
+    // оказаться по адресу уже удаленного
+    struct Handle {
+        uint64_t owner{0};
+        ThreadCounters* counters{nullptr};
+    };
+    thread_local Handle handle;
+
+    if (handle.owner != id_) {
+        auto counters = std::make_unique<ThreadCounters>();
+        handle.counters = counters.get();
+        handle.owner = id_;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        counters_.push_back(std::move(counters));
+    }
+    return *handle.counters;
+}
+
+void LoggerStats::Start() {
+    start_ns_.store(utils::time::ToNanoseconds(utils::time::GetMonotonicTime()),
+                    std::memory_order_relaxed);
+}
+
+ipc::LoggerStatsSnapshot LoggerStats::Snapshot() const {
+    ipc::LoggerStatsSnapshot snapshot{};
+    snapshot.version = ipc::kStatsVersion;
+
+    const uint64_t start = start_ns_.load(std::memory_order_relaxed);
+    const uint64_t now = utils::time::ToNanoseconds(utils::time::GetMonotonicTime());
+    snapshot.uptime_ns = start > 0 && now > start ? now - start : 0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& counters : counters_) {
+        snapshot.messages_received += Sum(counters->messages_received);
+        snapshot.bytes_received += Sum(counters->bytes_received);
+        snapshot.batches_received += Sum(counters->batches_received);
+        snapshot.pulses_received += Sum(counters->pulses_received);
+        snapshot.receive_errors += Sum(counters->receive_errors);
+        snapshot.records_written += Sum(counters->records_written);
+        snapshot.bytes_written += Sum(counters->bytes_written);
+        snapshot.flushes += Sum(counters->flushes);
+        SumHistogram(counters->reply_latency, snapshot.reply_latency);
+        SumHistogram(counters->write_latency, snapshot.write_latency);
+        SumHistogram(counters->flush_latency, snapshot.flush_latency);
+    }
+    return snapshot;
+}
+
+std::string LoggerStats::Format(const ipc::LoggerStatsSnapshot& current,
+                                const ipc::LoggerStatsSnapshot* previous) {
+    const ipc::LoggerStatsSnapshot zero{};
+    const ipc::LoggerStatsSnapshot& base = previous != nullptr ? *previous : zero;
+    const uint64_t elapsed = current.uptime_ns > base.uptime_ns
+                                 ? current.uptime_ns - base.uptime_ns
+                                 : 0;
+
+    // Квантили считаются по интервалу между снимками, как и скорости
+    const ipc::LatencyBuckets reply = Delta(current.reply_latency, base.reply_latency);
+    const ipc::LatencyBuckets write = Delta(current.write_latency, base.write_latency);
+    const ipc::LatencyBuckets flush = Delta(current.flush_latency, base.flush_latency);
+
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer),
+             "Stats: uptime %s, received %llu (%.0f msg/s, %.1f KiB/s), batches %llu, "
+             "pulses %llu, receive errors %llu, written %llu (%.0f msg/s, %.1f KiB/s), "
+             "flushes %llu, queue %u/%u of %u, dropped %llu, reply p50 %s p99 %s, "
+             "write p50 %s p99 %s, flush p50 %s p99 %s",
+             FormatDuration(current.uptime_ns).c_str(),
+             static_cast<unsigned long long>(current.messages_received),
+             Rate(current.messages_received, base.messages_received, elapsed),
+             Rate(current.bytes_received, base.bytes_received, elapsed) / 1024.0,
+             static_cast<unsigned long long>(current.batches_received),
+             static_cast<unsigned long long>(current.pulses_received),
+             static_cast<unsigned long long>(current.receive_errors),
+             static_cast<unsigned long long>(current.records_written),
+             Rate(current.records_written, base.records_written, elapsed),
+             Rate(current.bytes_written, base.bytes_written, elapsed) / 1024.0,
+             static_cast<unsigned long long>(current.flushes),
+             current.queue_depth, current.queue_depth_max, current.queue_capacity,
+             static_cast<unsigned long long>(current.messages_dropped),
+             FormatDuration(ipc::LatencyPercentile(reply, 50.0)).c_str(),
+             FormatDuration(ipc::LatencyPercentile(reply, 99.0)).c_str(),
+             FormatDuration(ipc::LatencyPercentile(write, 50.0)).c_str(),
+             FormatDuration(ipc::LatencyPercentile(write, 99.0)).c_str(),
+             FormatDuration(ipc::LatencyPercentile(flush, 50.0)).c_str(),
+             FormatDuration(ipc::LatencyPercentile(flush, 99.0)).c_str());
+    return buffer;
+}
+
+} // namespace nexus::logger
@@ -0,0 +1,111 @@
+#pragma once
+
+/**
+ * @file logger_stats.hpp
+ * @brief Внутренние метрики логгера: счетчики и гистограммы задержек по потокам
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Types
+#include "../../common/types/stats_types.hpp"
+
+namespace nexus::logger {
+
+/**
+ * @class LoggerStats
+ * @brief Метрики логгера с раздельными счетчиками для каждого потока
+ *
+ * Каждый поток (потоки приема, поток записи) пишет только в свой набор
+ * счетчиков, поэтому обновление - обычная relaxed-запись без атомарных
+ * read-modify-write операций и без разделения кэш-линий между потоками.
+ * Snapshot() суммирует наборы всех потоков, когда-либо обращавшихся к метрикам.
+ *
+ * @note Потокобезопасность: Local() и Snapshot() можно вызывать из любых потоков
+ */
+class LoggerStats {
+public:
+    /**
+     * @brief Счетчики одного потока
+     *
+     * Изменяются только потоком-владельцем через Add() и Record(),
+     * читаются любым потоком при сборе снимка.
+     */
+    struct alignas(64) ThreadCounters {
+        std::atomic<uint64_t> messages_received{0};
+        std::atomic<uint64_t> bytes_received{0};
+        std::atomic<uint64_t> batches_received{0};
+        std::atomic<uint64_t> pulses_received{0};
+        std::atomic<uint64_t> receive_errors{0};
+        std::atomic<uint64_t> records_written{0};
+        std::atomic<uint64_t> bytes_written{0};
+        std::atomic<uint64_t> flushes{0};
+
+        std::atomic<uint64_t> reply_latency[ipc::kLatencyBucketCount]{};
+        std::atomic<uint64_t> write_latency[ipc::kLatencyBucketCount]{};
+        std::atomic<uint64_t> flush_latency[ipc::kLatencyBucketCount]{};
+    };
+
+    LoggerStats();
+
+    LoggerStats(const LoggerStats&) = delete;
+    LoggerStats& operator=(const LoggerStats&) = delete;
+
+    /**
+     * @brief Счетчики текущего потока, при первом обращении создаются
+     */
+    ThreadCounters& Local();
+
+    /**
+     * @brief Увеличение счетчика потоком-владельцем
+     */
+    static void Add(std::atomic<uint64_t>& counter, const uint64_t value = 1) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + value,
+                      std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Учет задержки в гистограмме потока-владельца
+     * @param histogram Гистограмма из ThreadCounters
+     * @param nanoseconds Задержка в наносекундах
+     */
+    static void Record(std::atomic<uint64_t> (&histogram)[ipc::kLatencyBucketCount],
+                       const uint64_t nanoseconds) noexcept {
+        Add(histogram[ipc::LatencyBucketOf(nanoseconds)]);
+    }
+
+    /// @brief Начало отсчета времени работы (вызывается при запуске логгера)
+    void Start();
+
+    /**
+     * @brief Сумма счетчиков всех потоков
+     *
+     * Поля очереди заполняет вызывающий: состояние очереди метрикам не известно.
+     */
+    ipc::LoggerStatsSnapshot Snapshot() const;
+
+    /**
+     * @brief Однострочное описание снимка для вывода
+     * @param current Текущий снимок
+     * @param previous Предыдущий снимок: скорости и квантили считаются за интервал
+     *                 между снимками (nullptr - с запуска)
+     */
+    static std::string Format(const ipc::LoggerStatsSnapshot& current,
+                              const ipc::LoggerStatsSnapshot* previous = nullptr);
+
+private:
+    /// @brief Уникальный номер экземпляра для привязки счетчиков потока
+    const uint64_t id_;
+
+    std::atomic<uint64_t> start_ns_{0};
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<ThreadCounters>> counters_;
+};
+
+} // namespace nexus::logger
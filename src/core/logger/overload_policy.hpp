@@ -0,0 +1,27 @@
+#pragma once
+
+/**
+ * @file overload_policy.hpp
+ * @brief Поведение ограниченных буферов логирования при переполнении
+ */
+
+#include <cstdint>
+
+namespace nexus::logger {
+
+/**
+ * @brief Что делать с записью, когда буфер заполнен
+ *
+ * Политика задается отдельно для очереди логгера (BaseLogger::SetOverloadPolicy())
+ * и для буферов клиента (LoggerServiceConfig::overload_policy). Отброшенные записи
+ * считаются точно, их число периодически пишется в приемник строкой
+ * "N messages dropped".
+ */
+enum class OverloadPolicy : uint8_t {
+    BLOCK,           ///< Ждать освобождения места (отправитель блокируется)
+    DROP_NEWEST,     ///< Отбросить новую запись
+    DROP_OLDEST,     ///< Вытеснить самую старую запись из буфера
+    DROP_BELOW_ERROR ///< Отбрасывать записи ниже ERROR; ERROR и FATAL - в последнюю очередь
+};
+
+} // namespace nexus::logger
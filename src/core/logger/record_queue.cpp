@@ -0,0 +1,156 @@
+#include "record_queue.hpp"
+
+#include <algorithm>
+#include <utility>
+
+// Types
+#include "../../common/types/format_types.hpp"
+
+namespace nexus::logger {
+
+RecordQueue::RecordQueue(const size_t capacity, const OverloadPolicy policy)
+    : slots_(std::max<size_t>(capacity, 1)), policy_(policy) {
+}
+
+RecordQueue::Turn::Turn(RecordQueue& queue, const uint64_t sequence) : queue_(queue) {
+    std::unique_lock<std::mutex> lock(queue_.mutex_);
+    queue_.turn_changed_.wait(lock, [this, sequence] {
+        return queue_.current_turn_ == sequence;
+    });
+}
+
+RecordQueue::Turn::~Turn() {
+    {
+        std::lock_guard<std::mutex> lock(queue_.mutex_);
+        ++queue_.current_turn_;
+    }
+    queue_.turn_changed_.notify_all();
+}
+
+bool RecordQueue::Push(const RecordKind kind, const ipc::MessageCode code,
+                       const timespec& time, const std::string_view text,
+                       const Sender& sender) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!closed_ && size_ == slots_.size()
+        && !MakeRoom(kind, ipc::SeverityOfRecord(code, text), lock)) {
+        ++dropped_;
+        return true;
+    }
+
+    if (closed_) {
+        return false;
+    }
+
+    LogRecord& slot = slots_[(head_ + size_) % slots_.size()];
+    slot.kind = kind;
+    slot.code = code;
+    slot.sequence = current_turn_;
+    slot.time = time;
+    slot.sender = sender;
+    slot.text.assign(text.data(), text.size());
+    ++size_;
+    max_size_ = std::max(max_size_, size_);
+
+    lock.unlock();
+    not_empty_.notify_one();
+    return true;
+}
+
+size_t RecordQueue::PopBatch(std::vector<LogRecord>& records) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this] {
+        return closed_ || size_ > 0;
+    });
+
+    const size_t count = std::min(size_, records.size());
+    for (size_t i = 0; i < count; ++i) {
+        std::swap(records[i], slots_[head_]);
+        head_ = (head_ + 1) % slots_.size();
+    }
+    size_ -= count;
+
+    lock.unlock();
+    if (count > 0) {
+        not_full_.notify_all();
+    }
+    return count;
+}
+
+size_t RecordQueue::Depth(size_t& depth, size_t& max_depth) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    depth = size_;
+    max_depth = max_size_;
+    return slots_.size();
+}
+
+uint64_t RecordQueue::Dropped() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_;
+}
+
+uint64_t RecordQueue::TakeDropped() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint64_t unreported = dropped_ - dropped_reported_;
+    dropped_reported_ = dropped_;
+    return unreported;
+}
+
+bool RecordQueue::MakeRoom(const RecordKind kind, const ipc::Severity severity,
+                           std::unique_lock<std::mutex>& lock) {
+    if (kind == RecordKind::MESSAGE && policy_ != OverloadPolicy::BLOCK) {
+        // Новую запись отбросить дешевле всего: очередь не меняется
+        if (policy_ == OverloadPolicy::DROP_NEWEST
+            || (policy_ == OverloadPolicy::DROP_BELOW_ERROR && severity < ipc::SEVERITY_ERROR)) {
+            return false;
+        }
+
+        // Вытесняется самая старая запись (для ERROR и FATAL - самая старая ниже ERROR),
+        // если вытеснять нечего - ждем места, как при BLOCK
+        const size_t victim = FindVictim(policy_ == OverloadPolicy::DROP_BELOW_ERROR);
+        if (victim != size_) {
+            RemoveAt(victim);
+            ++dropped_;
+            return true;
+        }
+    }
+
+    not_full_.wait(lock, [this] {
+        return closed_ || size_ < slots_.size();
+    });
+    return true;
+}
+
+size_t RecordQueue::FindVictim(const bool below_error) const {
+    for (size_t offset = 0; offset < size_; ++offset) {
+        const LogRecord& record = slots_[(head_ + offset) % slots_.size()];
+        if (record.kind != RecordKind::MESSAGE) {
+            continue;
+        }
+        if (!below_error
+            || ipc::SeverityOfRecord(record.code, record.text) < ipc::SEVERITY_ERROR) {
+            return offset;
+        }
+    }
+    return size_;
+}
+
+void RecordQueue::RemoveAt(const size_t offset) {
+    // Записи перед удаляемой сдвигаются на одну позицию к хвосту обменом,
+    // строка удаленной записи уходит в освобождаемый слот головы
+    for (size_t i = offset; i > 0; --i) {
+        std::swap(slots_[(head_ + i) % slots_.size()], slots_[(head_ + i - 1) % slots_.size()]);
+    }
+    head_ = (head_ + 1) % slots_.size();
+    --size_;
+}
+
+void RecordQueue::Close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    not_empty_.notify_all();
+    not_full_.notify_all();
+}
+
+} // namespace nexus::logger
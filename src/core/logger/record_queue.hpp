@@ -0,0 +1,150 @@
+#pragma once
+
+/**
+ * @file record_queue.hpp
+ * @brief Ограниченная очередь записей между потоком приема и потоком записи
+ */
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+// Logger
+#include "log_record.hpp"
+#include "overload_policy.hpp"
+
+namespace nexus::logger {
+
+/**
+ * @class RecordQueue
+ * @brief Ограниченная блокирующая очередь записей с переиспользуемыми слотами
+ *
+ * Слоты выделяются один раз при создании. Производитель копирует текст в строку слота,
+ * потребитель забирает записи обменом (swap), поэтому буферы строк циркулируют
+ * между очередью и потребителем без повторных выделений памяти.
+ *
+ * Для нескольких потоков приема очередь служит этапом слияния: производитель
+ * с номером приема N добавляет записи только после того, как производители
+ * с номерами 0..N-1 завершили свой ход (см. Turn). Порядок записей в очереди
+ * поэтому совпадает с порядком приема, независимо от планирования потоков.
+ *
+ * При заполненной очереди действует OverloadPolicy. Отбрасываются и вытесняются
+ * только клиентские записи (RecordKind::MESSAGE): служебные записи и регистрации
+ * форматов всегда ждут места, поэтому счетчик отброшенных записей точен, а
+ * текст LOG_FORMATTED всегда можно собрать.
+ *
+ * @note Потокобезопасность: thread-safe для любого числа производителей и потребителей
+ */
+class RecordQueue {
+public:
+    /**
+     * @class Turn
+     * @brief RAII-ход производителя с заданным порядковым номером приема
+     *
+     * Конструктор ожидает завершения ходов всех меньших номеров, деструктор
+     * передает ход следующему номеру. Каждый номер должен быть пройден ровно один раз,
+     * даже если производитель ничего не добавил.
+     */
+    class Turn {
+    public:
+        Turn(RecordQueue& queue, uint64_t sequence);
+        ~Turn();
+
+        Turn(const Turn&) = delete;
+        Turn& operator=(const Turn&) = delete;
+
+    private:
+        RecordQueue& queue_;
+    };
+
+    /**
+     * @brief Конструктор
+     * @param capacity Максимальное число записей в очереди
+     * @param policy Поведение при заполненной очереди
+     */
+    explicit RecordQueue(size_t capacity, OverloadPolicy policy = OverloadPolicy::BLOCK);
+
+    RecordQueue(const RecordQueue&) = delete;
+    RecordQueue& operator=(const RecordQueue&) = delete;
+
+    /**
+     * @brief Добавление записи
+     * @param sender Отправитель клиентской записи
+     * @return false, если очередь закрыта
+     *
+     * При заполненной очереди блокируется (OverloadPolicy::BLOCK) либо отбрасывает
+     * новую или вытесняет старую запись по политике. Отброшенная новая запись
+     * считается добавленной: возвращается true.
+     */
+    bool Push(RecordKind kind, ipc::MessageCode code, const timespec& time,
+              std::string_view text, const Sender& sender = {});
+
+    /**
+     * @brief Извлечение пачки записей, блокируется при пустой очереди
+     * @param records Буфер потребителя, его записи обмениваются со слотами очереди
+     * @return Число извлеченных записей (не больше records.size());
+     *         0 - очередь закрыта и пуста
+     */
+    size_t PopBatch(std::vector<LogRecord>& records);
+
+    /**
+     * @brief Закрытие очереди: новые записи не принимаются,
+     *        потребитель дочитывает оставшиеся
+     */
+    void Close();
+
+    /**
+     * @brief Состояние очереди для метрик
+     * @param depth [out] Текущее число записей
+     * @param max_depth [out] Наибольшее число записей с момента создания
+     * @return Емкость очереди
+     */
+    size_t Depth(size_t& depth, size_t& max_depth);
+
+    /// @brief Число записей, отброшенных с момента создания
+    uint64_t Dropped();
+
+    /// @brief Число записей, отброшенных после предыдущего вызова
+    uint64_t TakeDropped();
+
+private:
+    /**
+     * @brief Освобождение места под новую запись по политике переполнения
+     * @param lock Захваченная блокировка очереди (освобождается на время ожидания)
+     * @return false - новая запись должна быть отброшена
+     */
+    bool MakeRoom(RecordKind kind, ipc::Severity severity,
+                  std::unique_lock<std::mutex>& lock);
+
+    /**
+     * @brief Поиск самой старой клиентской записи
+     * @param below_error Только записи ниже уровня ERROR
+     * @return Смещение от головы очереди или size_, если записи нет
+     */
+    size_t FindVictim(bool below_error) const;
+
+    /// @brief Удаление записи по смещению от головы с сохранением порядка остальных
+    void RemoveAt(size_t offset);
+
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::condition_variable turn_changed_;
+
+    std::vector<LogRecord> slots_;
+    size_t head_{0};
+    size_t size_{0};
+    size_t max_size_{0};
+    bool closed_{false};
+
+    const OverloadPolicy policy_;
+    uint64_t dropped_{0};
+    uint64_t dropped_reported_{0};
+
+    /// @brief Номер приема, чей ход сейчас (он же номер добавляемых записей)
+    uint64_t current_turn_{0};
+};
+
+} // namespace nexus::logger
@@ -0,0 +1,46 @@
+#include "sender_cache.hpp"
+
+namespace nexus::logger {
+
+SenderCache::SenderCache(const size_t capacity) : capacity_(capacity > 0 ? capacity : 1) {
+}
+
+void SenderCache::Register(const uint32_t pid, const std::string_view name) {
+    auto it = names_.find(pid);
+    if (it == names_.end()) {
+        // Клиенты не сообщают о завершении, поэтому таблица ограничена по размеру:
+        // вытесняется клиент, дольше всех не присылавший записей
+        if (names_.size() >= capacity_) {
+            names_.erase(recent_.back());
+            recent_.pop_back();
+        }
+        recent_.push_front(pid);
+        it = names_.emplace(pid, Entry{{}, recent_.begin()}).first;
+    } else {
+        recent_.splice(recent_.begin(), recent_, it->second.position);
+    }
+
+    it->second.name.assign(name.data(), name.size());
+    last_name_ = nullptr;
+}
+
+std::string_view SenderCache::Name(const uint32_t pid) {
+    if (last_name_ != nullptr && last_pid_ == pid) {
+        return *last_name_;
+    }
+
+    const auto it = names_.find(pid);
+    if (it == names_.end()) {
+        unknown_ = std::to_string(pid);
+        return unknown_;
+    }
+
+    // Подряд идущие записи одного процесса порядок не меняют: их отсекает last_pid_
+    recent_.splice(recent_.begin(), recent_, it->second.position);
+
+    last_pid_ = pid;
+    last_name_ = &it->second.name;
+    return *last_name_;
+}
+
+} // namespace nexus::logger
@@ -0,0 +1,71 @@
+#pragma once
+
+/**
+ * @file sender_cache.hpp
+ * @brief Имена клиентов логгера по идентификатору процесса
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace nexus::logger {
+
+/**
+ * @class SenderCache
+ * @brief Таблица имен, зарегистрированных клиентами через LOG_REGISTER
+ *
+ * Клиент передает имя один раз при подключении, а в записях логгер узнает
+ * отправителя по pid из сведений транспорта (MsgReceive на QNX, SO_PEERCRED
+ * на Linux) или из слота разделяемого буфера. Регистрация и записи проходят
+ * через одну очередь логгера, поэтому имя известно раньше первой записи клиента.
+ *
+ * @note Не потокобезопасен: используется только потоком записи
+ */
+class SenderCache {
+public:
+    /**
+     * @brief Конструктор
+     * @param capacity Наибольшее число имен; при переполнении вытесняется имя
+     *                 клиента, дольше всех не присылавшего записей
+     */
+    explicit SenderCache(size_t capacity = 1024);
+
+    /**
+     * @brief Сохранение имени клиента из сообщения LOG_REGISTER
+     * @param pid Процесс клиента по сведениям транспорта
+     * @param name Имя клиента
+     */
+    void Register(uint32_t pid, std::string_view name);
+
+    /**
+     * @brief Имя клиента
+     * @return Зарегистрированное имя или номер процесса, если клиент не регистрировался;
+     *         строка действительна до следующего вызова
+     */
+    std::string_view Name(uint32_t pid);
+
+private:
+    struct Entry {
+        std::string name;
+        std::list<uint32_t>::iterator position; ///< Место в recent_
+    };
+
+    const size_t capacity_;
+    std::unordered_map<uint32_t, Entry> names_;
+
+    /// @brief Процессы от недавно встреченных к давно не встречавшимся
+    std::list<uint32_t> recent_;
+
+    /// @brief Последний найденный клиент: подряд обычно идут записи одного процесса
+    uint32_t last_pid_{0};
+    const std::string* last_name_{nullptr};
+
+    /// @brief Буфер номера процесса для незарегистрированных клиентов
+    std::string unknown_;
+};
+
+} // namespace nexus::logger
@@ -16,7 +16,9 @@ public:
 
         // Имитация работы приложения
         for (int i = 0; i < 5; ++i) {
-            LOG_INFO("Processing item " + std::to_string(i));
+            LOG_INFO_FMT("Processing item {}", i);
+            // Отладочный уровень выключен порогом по умолчанию и не стоит ничего
+            LOG_DEBUG_FMT("Item {} sleeps for {} ms", i, 100);
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
             if (i == 2) {
@@ -72,11 +74,11 @@ int main() {
         std::cout << "Stopping logger...\n";
 
         // Подключаемся к логгеру и отправляем пульс shutdown
-        int coid = name_open(nexus::channels::LOGGER.c_str(), 0);
+        int coid = nexus::ipc::Connect(nexus::channels::LOGGER);
         if (coid != -1) {
             // Отправляем пульс shutdown
-            MsgSendPulse(coid, 20, ipc::PULSE_SHUTDOWN, 0);
-            name_close(coid);
+            ipc::SendPulse(coid, 20, ipc::PULSE_SHUTDOWN, 0);
+            nexus::ipc::Disconnect(coid);
         }
         // Ждем завершения логгера
         if (logger_thread.joinable()) {
@@ -1,16 +1,15 @@
 #include "console_logger.hpp"
-#include <iostream>
 
 namespace nexus::logger {
 ConsoleLogger::ConsoleLogger(const std::string& name)
     : BaseLogger(name) {
 }
 
-void ConsoleLogger::Write(std::string formatted_message) {
-    std::cout << formatted_message << '\n';
+void ConsoleLogger::Write(const std::string_view formatted_message) {
+    sink_.Write(formatted_message);
 }
 
 void ConsoleLogger::Flush() {
-    std::cout.flush();
+    sink_.Flush();
 }
-} // namespace nexus::logger
\ No newline at end of file
+} // namespace nexus::logger
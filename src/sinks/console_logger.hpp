@@ -3,13 +3,19 @@
 // Base
 #include "../core/logger/base_logger.hpp"
 
+// Sinks
+#include "console_sink.hpp"
+
 namespace nexus::logger {
 class ConsoleLogger final : public BaseLogger {
 public:
     explicit ConsoleLogger(const std::string& name);
 
 protected:
-    void Write(std::string formatted_message) override;
+    void Write(std::string_view formatted_message) override;
     void Flush() override;
+
+private:
+    ConsoleSink sink_;
 };
-} // namespace nexus::loger
\ No newline at end of file
+} // namespace nexus::loger
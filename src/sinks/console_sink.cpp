@@ -0,0 +1,13 @@
+#include "console_sink.hpp"
+#include <iostream>
+
+namespace nexus::logger {
+void ConsoleSink::Write(const std::string_view line) {
+    std::cout.write(line.data(), static_cast<std::streamsize>(line.size()));
+    std::cout.put('\n');
+}
+
+void ConsoleSink::Flush() {
+    std::cout.flush();
+}
+} // namespace nexus::logger
@@ -0,0 +1,12 @@
+#pragma once
+
+// Sinks
+#include "log_sink.hpp"
+
+namespace nexus::logger {
+class ConsoleSink final : public LogSink {
+public:
+    void Write(std::string_view line) override;
+    void Flush() override;
+};
+} // namespace nexus::logger
@@ -0,0 +1,184 @@
+#include "direct_file_backend.hpp"
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace nexus::logger {
+
+namespace {
+// Выравнивание буферов по размеру страницы
+constexpr size_t kBufferAlignment = 4096;
+
+char* AllocateAligned(const size_t size) {
+    void* buffer = nullptr;
+    if (posix_memalign(&buffer, kBufferAlignment, size) != 0) {
+        throw std::runtime_error("Cannot allocate log file buffer");
+    }
+    return static_cast<char*>(buffer);
+}
+} // namespace
+
+DirectFileBackend::DirectFileBackend(const std::string& filepath, const size_t buffer_size)
+    : buffer_size_(buffer_size < kBufferAlignment ? kBufferAlignment : buffer_size) {
+    active_.reset(AllocateAligned(buffer_size_));
+    submitted_.reset(AllocateAligned(buffer_size_));
+
+    fd_ = open(filepath.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ == -1) {
+        throw std::runtime_error("Cannot open log file: " + filepath + ": "
+                                 + std::strerror(errno));
+    }
+
+    io_thread_ = std::thread(&DirectFileBackend::IoLoop, this);
+}
+
+DirectFileBackend::~DirectFileBackend() {
+    Flush();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    io_cv_.notify_one();
+    io_thread_.join();
+
+    close(fd_);
+}
+
+void DirectFileBackend::Append(const std::string_view line) {
+    const size_t size = line.size() + 1;
+
+    if (active_size_ + size > buffer_size_) {
+        SubmitActive();
+    }
+
+    if (size > buffer_size_) {
+        // Строка больше буфера: дожидаемся записи предыдущих данных
+        // и пишем ее напрямую, не копируя
+        std::unique_lock<std::mutex> lock(mutex_);
+        WaitIdle(lock);
+
+        char newline = '\n';
+        iovec parts[2];
+        parts[0].iov_base = const_cast<char*>(line.data());
+        parts[0].iov_len = line.size();
+        parts[1].iov_base = &newline;
+        parts[1].iov_len = 1;
+
+        ssize_t written;
+        do {
+            written = writev(fd_, parts, 2);
+        } while (written == -1 && errno == EINTR);
+
+        if (written >= 0 && static_cast<size_t>(written) < size) {
+            // Частичная запись: дописываем остаток обычным способом
+            const auto offset = static_cast<size_t>(written);
+            if (offset < line.size()) {
+                WriteAll(line.data() + offset, line.size() - offset);
+            }
+            WriteAll(&newline, 1);
+        }
+        return;
+    }
+
+    char* out = active_.get() + active_size_;
+    std::memcpy(out, line.data(), line.size());
+    out[line.size()] = '\n';
+    active_size_ += size;
+}
+
+void DirectFileBackend::Flush() {
+    SubmitActive();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    WaitIdle(lock);
+}
+
+bool DirectFileBackend::Reopen(const std::string& filepath) {
+    const int fd = open(filepath.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd == -1) {
+        return false;
+    }
+
+    // dup2() атомарно закрывает прежний файл и подставляет новый под тем же номером
+    int status;
+    do {
+        status = dup2(fd, fd_);
+    } while (status == -1 && errno == EINTR);
+    close(fd);
+    return status != -1;
+}
+
+void DirectFileBackend::SubmitActive() {
+    if (active_size_ == 0) {
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        WaitIdle(lock);
+
+        std::swap(active_, submitted_);
+        submitted_size_ = active_size_;
+        io_busy_ = true;
+    }
+    io_cv_.notify_one();
+
+    active_size_ = 0;
+}
+
+void DirectFileBackend::WaitIdle(std::unique_lock<std::mutex>& lock) {
+    idle_cv_.wait(lock, [this] {
+        return !io_busy_;
+    });
+}
+
+void DirectFileBackend::IoLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        io_cv_.wait(lock, [this] {
+            return io_busy_ || stop_;
+        });
+
+        if (io_busy_) {
+            // Буфер принадлежит потоку ввода-вывода до сброса io_busy_
+            const char* data = submitted_.get();
+            const size_t size = submitted_size_;
+
+            lock.unlock();
+            WriteAll(data, size);
+            lock.lock();
+
+            io_busy_ = false;
+            idle_cv_.notify_all();
+            continue;
+        }
+
+        if (stop_) {
+            return;
+        }
+    }
+}
+
+void DirectFileBackend::WriteAll(const char* data, size_t size) const {
+    while (size > 0) {
+        const ssize_t written = write(fd_, data, size);
+        if (written == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // Ошибка записи (например, нет места): блок теряется, как и в std::ofstream
+            return;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+} // namespace nexus::logger
@@ -0,0 +1,90 @@
+#pragma once
+
+/**
+ * @file direct_file_backend.hpp
+ * @brief Запись файла лога через дескриптор O_APPEND с двойной буферизацией
+ */
+
+#include <condition_variable>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Base
+#include "file_backend.hpp"
+
+namespace nexus::logger {
+
+/**
+ * @class DirectFileBackend
+ * @brief Запись строк крупными блоками в обход iostream
+ *
+ * Строки копируются в активный выровненный буфер. Заполненный буфер передается
+ * потоку ввода-вывода, который записывает его одним вызовом write(), пока поток
+ * записи логгера продолжает заполнять второй буфер. Строки больше буфера
+ * записываются напрямую через writev() без промежуточного копирования.
+ */
+class DirectFileBackend final : public FileBackend {
+public:
+    /**
+     * @brief Конструктор
+     * @param filepath Путь к файлу лога (открывается с O_APPEND)
+     * @param buffer_size Размер каждого из двух буферов в байтах
+     * @throw std::runtime_error При ошибках открытия файла или выделения буферов
+     */
+    explicit DirectFileBackend(const std::string& filepath, size_t buffer_size = 1 << 20);
+    ~DirectFileBackend() override;
+
+    void Append(std::string_view line) override;
+    void Flush() override;
+
+    /**
+     * @brief Переключение на новый файл заменой дескриптора через dup2()
+     *
+     * Номер дескриптора не меняется, поэтому поток ввода-вывода не требует
+     * синхронизации: каждая запись целиком попадает в прежний или новый файл.
+     */
+    bool Reopen(const std::string& filepath) override;
+
+private:
+    struct FreeDeleter {
+        void operator()(char* buffer) const noexcept {
+            std::free(buffer);
+        }
+    };
+    using AlignedBuffer = std::unique_ptr<char, FreeDeleter>;
+
+    /// @brief Передача активного буфера потоку ввода-вывода
+    void SubmitActive();
+
+    /// @brief Ожидание завершения записи переданного буфера
+    void WaitIdle(std::unique_lock<std::mutex>& lock);
+
+    /// @brief Цикл потока ввода-вывода
+    void IoLoop();
+
+    /// @brief Запись блока целиком с повтором при частичной записи
+    void WriteAll(const char* data, size_t size) const;
+
+    int fd_{-1};
+    const size_t buffer_size_;
+
+    /// @brief Буфер, заполняемый потоком записи логгера
+    AlignedBuffer active_;
+    size_t active_size_{0};
+
+    /// @brief Буфер, переданный потоку ввода-вывода
+    AlignedBuffer submitted_;
+    size_t submitted_size_{0};
+    bool io_busy_{false};
+    bool stop_{false};
+
+    std::mutex mutex_;
+    std::condition_variable io_cv_;
+    std::condition_variable idle_cv_;
+    std::thread io_thread_;
+};
+
+} // namespace nexus::logger
@@ -0,0 +1,53 @@
+#pragma once
+
+/**
+ * @file file_backend.hpp
+ * @brief Интерфейс механизма записи строк в файл для FileLogger
+ */
+
+#include <string>
+#include <string_view>
+
+namespace nexus::logger {
+
+/**
+ * @brief Способ записи файла лога
+ */
+enum class FileWriteMode {
+    STREAM, ///< std::ofstream, запись построчно
+    DIRECT, ///< Дескриптор O_APPEND, двойная буферизация и запись крупными блоками
+    MAPPED  ///< Предвыделенные сегменты файла, отображенные в память, запись копированием
+};
+
+/**
+ * @class FileBackend
+ * @brief Механизм записи строк в открытый файл лога
+ *
+ * Вызывается только из потока записи логгера.
+ */
+class FileBackend {
+public:
+    virtual ~FileBackend() = default;
+
+    /**
+     * @brief Добавление строки с завершающим переводом строки
+     * @param line Строка без перевода строки
+     */
+    virtual void Append(std::string_view line) = 0;
+
+    /**
+     * @brief Запись всех накопленных данных в файл
+     */
+    virtual void Flush() = 0;
+
+    /**
+     * @brief Переключение записи на новый файл при ротации
+     * @param filepath Путь к новому файлу
+     * @return true при успехе; при ошибке запись продолжается в прежний файл
+     *
+     * @note Накопленные данные должны быть предварительно записаны через Flush()
+     */
+    virtual bool Reopen(const std::string& filepath) = 0;
+};
+
+} // namespace nexus::logger
@@ -1,21 +1,40 @@
 #pragma once
-#include <fstream>
+#include <string>
 
 // Base
 #include "../core/logger/base_logger.hpp"
 
+// Sinks
+#include "file_sink.hpp"
+
 namespace nexus::logger {
 class FileLogger final : public BaseLogger {
 public:
-    explicit FileLogger(const std::string& server_name, std::string filepath);
-    ~FileLogger() override;
+    /**
+     * @brief Конструктор
+     * @param server_name Имя логгера
+     * @param filepath Путь к файлу лога
+     * @param mode Способ записи: построчно через std::ofstream, блоками через O_APPEND
+     *             или копированием в отображенные в память сегменты
+     * @throw std::runtime_error При ошибках создания директории или открытия файла
+     */
+    explicit FileLogger(const std::string& server_name, std::string filepath,
+                        FileWriteMode mode = FileWriteMode::STREAM);
+
+    /**
+     * @brief Настройка ротации файла лога (см. FileSink::SetRotationPolicy())
+     * @param policy Пороги размера и времени, ограничения хранения и сжатие сегментов
+     *
+     * @throw std::runtime_error Если запрошено сжатие, а сборка без zlib
+     * @note Должен вызываться до Run()
+     */
+    void SetRotationPolicy(const RotationPolicy& policy);
 
 protected:
-    void Write(std::string formatted_message) override;
+    void Write(std::string_view formatted_message) override;
     void Flush() override;
 
 private:
-    std::ofstream file_;
-    std::string filepath_;
+    FileSink sink_;
 };
-} // namespace nexus::logger
\ No newline at end of file
+} // namespace nexus::logger
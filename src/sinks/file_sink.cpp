@@ -0,0 +1,165 @@
+#include "file_sink.hpp"
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <stdexcept>
+#include <utility>
+
+// Sinks
+#include "direct_file_backend.hpp"
+#include "mapped_file_backend.hpp"
+#include "stream_file_backend.hpp"
+
+// Utils
+#include "common/utils/path_utils.hpp"
+#include "common/utils/time_utils.hpp"
+
+namespace nexus::logger {
+
+namespace {
+// Пауза перед повтором неудавшейся ротации, секунды
+constexpr time_t kRotationRetryDelay = 1;
+
+size_t FileSize(const std::string& filepath) {
+    struct stat info{};
+    return stat(filepath.c_str(), &info) == 0 ? static_cast<size_t>(info.st_size) : 0;
+}
+} // namespace
+
+FileSink::FileSink(std::string filepath, const FileWriteMode mode)
+    : filepath_(std::move(filepath)) {
+    // Создаем директорию если нужно
+    if (!utils::path::EnsureDirectoryExists(filepath_)) {
+        throw std::runtime_error("Cannot create directory for log file: "
+                                 + filepath_);
+    }
+
+    if (mode == FileWriteMode::DIRECT) {
+        backend_ = std::make_unique<DirectFileBackend>(filepath_);
+    } else if (mode == FileWriteMode::MAPPED) {
+        backend_ = std::make_unique<MappedFileBackend>(filepath_);
+    } else {
+        backend_ = std::make_unique<StreamFileBackend>(filepath_);
+    }
+}
+
+FileSink::~FileSink() = default;
+
+void FileSink::SetRotationPolicy(const RotationPolicy& policy) {
+    if (policy.compression != SegmentCompression::NONE
+        && !SegmentArchiver::CompressionAvailable()) {
+        throw std::runtime_error("Log segment compression is not available (built without zlib): "
+                                 + filepath_);
+    }
+
+    rotation_ = policy;
+    rotation_enabled_ = policy.max_size > 0 || policy.interval.count() > 0;
+
+    archiver_.reset();
+    if (policy.max_files > 0 || policy.max_age.count() > 0
+        || policy.compression != SegmentCompression::NONE) {
+        archiver_ = std::make_unique<SegmentArchiver>(filepath_, policy);
+    }
+
+    const time_t now = utils::time::GetCoarseTime().tv_sec;
+    next_rotation_ = NextBoundary(now);
+    file_size_ = 0;
+
+    struct stat info{};
+    if (stat(filepath_.c_str(), &info) == 0) {
+        file_size_ = static_cast<size_t>(info.st_size);
+
+        // Логгер был остановлен до границы интервала, а запущен после нее
+        if (policy.interval.count() > 0 && file_size_ > 0
+            && NextBoundary(info.st_mtime) <= now) {
+            Rotate(now, info.st_mtime);
+        }
+    }
+}
+
+void FileSink::Write(const std::string_view line) {
+    if (rotation_enabled_) {
+        RotateIfDue(line.size() + 1);
+        file_size_ += line.size() + 1;
+    }
+    backend_->Append(line);
+}
+
+void FileSink::Flush() {
+    backend_->Flush();
+}
+
+void FileSink::RotateIfDue(const size_t line_size) {
+    const time_t now = utils::time::GetCoarseTime().tv_sec;
+    const bool by_time = now >= next_rotation_;
+    const bool by_size = rotation_.max_size > 0 && file_size_ > 0
+                         && file_size_ + line_size > rotation_.max_size;
+
+    if ((by_time || by_size) && now >= retry_after_) {
+        Rotate(now, now);
+    }
+}
+
+bool FileSink::Rotate(const time_t now, const time_t stamp) {
+    // Строки, принятые до ротации, остаются в закрываемом сегменте
+    backend_->Flush();
+
+    std::string segment = std::move(unfinished_segment_);
+    unfinished_segment_.clear();
+    if (segment.empty()) {
+        segment = SegmentName(stamp);
+        if (std::rename(filepath_.c_str(), segment.c_str()) != 0) {
+            // Файл удален или перемещен извне: достаточно открыть новый
+            segment.clear();
+        }
+    }
+
+    // Директорию могли удалить вместе со старыми логами
+    if (!utils::path::EnsureDirectoryExists(filepath_) || !backend_->Reopen(filepath_)) {
+        unfinished_segment_ = std::move(segment);
+        retry_after_ = now + kRotationRetryDelay;
+        return false;
+    }
+
+    file_size_ = FileSize(filepath_);
+    next_rotation_ = NextBoundary(now);
+    retry_after_ = 0;
+
+    if (archiver_ && !segment.empty()) {
+        archiver_->Submit(std::move(segment));
+    }
+    return true;
+}
+
+std::string FileSink::SegmentName(const time_t stamp) const {
+    tm local{};
+    localtime_r(&stamp, &local);
+
+    char suffix[32];
+    strftime(suffix, sizeof(suffix), ".%Y%m%d-%H%M%S", &local);
+
+    // Несколько ротаций по размеру за секунду получают номера .1, .2, ...
+    const std::string base = filepath_ + suffix;
+    std::string name = base;
+    for (unsigned n = 1; access(name.c_str(), F_OK) == 0
+                         || access((name + ".gz").c_str(), F_OK) == 0;
+         ++n) {
+        name = base + "." + std::to_string(n);
+    }
+    return name;
+}
+
+time_t FileSink::NextBoundary(const time_t now) const {
+    const time_t interval = static_cast<time_t>(rotation_.interval.count());
+    if (interval <= 0) {
+        return std::numeric_limits<time_t>::max();
+    }
+
+    // Границы выравниваются по местному времени: суточная ротация - в полночь
+    tm local{};
+    localtime_r(&now, &local);
+    const time_t offset = static_cast<time_t>(local.tm_gmtoff);
+    return ((now + offset) / interval + 1) * interval - offset;
+}
+} // namespace nexus::logger
@@ -0,0 +1,81 @@
+#pragma once
+#include <ctime>
+#include <limits>
+#include <memory>
+#include <string>
+
+// Sinks
+#include "file_backend.hpp"
+#include "log_sink.hpp"
+#include "rotation_policy.hpp"
+#include "segment_archiver.hpp"
+
+namespace nexus::logger {
+/**
+ * @class FileSink
+ * @brief Запись строк в файл с ротацией по размеру и времени
+ */
+class FileSink final : public LogSink {
+public:
+    /**
+     * @brief Конструктор
+     * @param filepath Путь к файлу лога
+     * @param mode Способ записи: построчно через std::ofstream, блоками через O_APPEND
+     *             или копированием в отображенные в память сегменты
+     * @throw std::runtime_error При ошибках создания директории или открытия файла
+     */
+    explicit FileSink(std::string filepath, FileWriteMode mode = FileWriteMode::STREAM);
+    ~FileSink() override;
+
+    /**
+     * @brief Настройка ротации файла лога
+     * @param policy Пороги размера и времени, ограничения хранения и сжатие сегментов
+     *
+     * Ротация выполняется потоком записи перед очередной строкой: накопленные данные
+     * сбрасываются, файл переименовывается в сегмент <файл>.<ГГГГММДД-ЧЧММСС> (время
+     * закрытия), и запись переключается на новый файл по прежнему пути. Сжатие
+     * и удаление старых сегментов выполняет фоновый поток, запись их не ждет.
+     * Непустой файл, оставшийся от прошедшего интервала, ротируется сразу.
+     *
+     * @throw std::runtime_error Если запрошено сжатие, а сборка без zlib
+     * @note Должен вызываться до первой записи
+     */
+    void SetRotationPolicy(const RotationPolicy& policy);
+
+    void Write(std::string_view line) override;
+    void Flush() override;
+
+private:
+    /// @brief Ротация, если строка не помещается в max_size или начался новый интервал
+    void RotateIfDue(size_t line_size);
+
+    /**
+     * @brief Переключение на новый файл
+     * @param now Текущее время
+     * @param stamp Время закрытия сегмента для его имени
+     * @return false, если новый файл не открылся и запись идет в прежний
+     */
+    bool Rotate(time_t now, time_t stamp);
+
+    /// @brief Свободное имя сегмента для времени закрытия
+    std::string SegmentName(time_t stamp) const;
+
+    /// @brief Ближайшая после now граница интервала ротации по местному времени
+    time_t NextBoundary(time_t now) const;
+
+    /// @brief Обслуживает закрытые сегменты и переживает backend_
+    std::unique_ptr<SegmentArchiver> archiver_;
+
+    std::unique_ptr<FileBackend> backend_;
+    std::string filepath_;
+
+    RotationPolicy rotation_;
+    bool rotation_enabled_{false};
+    size_t file_size_{0};
+    time_t next_rotation_{std::numeric_limits<time_t>::max()};
+    time_t retry_after_{0};
+
+    /// @brief Сегмент, в который продолжается запись после неудачного открытия нового файла
+    std::string unfinished_segment_;
+};
+} // namespace nexus::logger
@@ -0,0 +1,38 @@
+#pragma once
+
+/**
+ * @file log_sink.hpp
+ * @brief Интерфейс приемника готовых строк лога
+ */
+
+#include <string_view>
+
+namespace nexus::logger {
+
+/**
+ * @class LogSink
+ * @brief Конечное хранилище строк лога: консоль, файл и т.д.
+ *
+ * Приемник получает уже отформатированные строки и не знает о протоколе
+ * и очередях логгера. Один и тот же приемник служит и одиночному логгеру
+ * (ConsoleLogger, FileLogger), и одному из выходов MultiSinkLogger.
+ *
+ * @note Вызывается только из одного потока записи
+ */
+class LogSink {
+public:
+    virtual ~LogSink() = default;
+
+    /**
+     * @brief Запись строки
+     * @param line Строка без перевода строки, действительна только на время вызова
+     */
+    virtual void Write(std::string_view line) = 0;
+
+    /**
+     * @brief Сброс буферов: после возврата записанные строки в конечном хранилище
+     */
+    virtual void Flush() = 0;
+};
+
+} // namespace nexus::logger
@@ -0,0 +1,310 @@
+#include "mapped_file_backend.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace nexus::logger {
+
+namespace {
+// Размер блока при поиске конца данных
+constexpr size_t kScanChunk = 64 * 1024;
+
+// Объем записанных данных, после которого они передаются фоновому потоку
+constexpr uint64_t kSubmitChunk = 1 << 20;
+
+// Насколько впереди позиции записи фоновый поток отображает страницы
+constexpr uint64_t kPrefaultAhead = 4 << 20;
+
+// Предотображение за один проход: столько максимум ждет снятие отображения
+constexpr uint64_t kPrefaultChunk = 1 << 20;
+
+size_t PageSize() {
+    static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return page_size;
+}
+
+// Резервирование места под сегмент, чтобы запись в отображение не получила SIGBUS
+bool Preallocate(const int fd, const uint64_t offset, const size_t size) {
+#if defined(__linux__)
+    int status;
+    do {
+        status = fallocate(fd, 0, static_cast<off_t>(offset), static_cast<off_t>(size));
+    } while (status == -1 && errno == EINTR);
+    if (status == 0) {
+        return true;
+    }
+    if (errno != EOPNOTSUPP && errno != ENOSYS) {
+        return false;
+    }
+#endif
+    // Файловая система без предвыделения: только расширяем файл
+    struct stat info{};
+    if (fstat(fd, &info) != 0) {
+        return false;
+    }
+    const uint64_t end = offset + size;
+    return static_cast<uint64_t>(info.st_size) >= end
+           || ftruncate(fd, static_cast<off_t>(end)) == 0;
+}
+
+void SyncRange(const int fd, const uint64_t begin, const uint64_t end) {
+#if defined(__linux__)
+    // Запуск записи без ожидания ее завершения
+    sync_file_range(fd, static_cast<off_t>(begin), static_cast<off_t>(end - begin),
+                    SYNC_FILE_RANGE_WRITE);
+#else
+    (void)begin;
+    (void)end;
+    fdatasync(fd);
+#endif
+}
+
+// Отображение страниц для записи без изменения их содержимого
+void Prefault(char* address, const size_t size) {
+#ifdef MADV_POPULATE_WRITE
+    madvise(address, size, MADV_POPULATE_WRITE);
+#else
+    (void)address;
+    (void)size;
+#endif
+}
+
+// Длина данных: позиция после последнего ненулевого байта
+uint64_t DataLength(const int fd, uint64_t size) {
+    char buffer[kScanChunk];
+    while (size > 0) {
+        const size_t chunk = static_cast<size_t>(std::min<uint64_t>(size, kScanChunk));
+        const ssize_t received = pread(fd, buffer, chunk, static_cast<off_t>(size - chunk));
+        if (received != static_cast<ssize_t>(chunk)) {
+            return size;
+        }
+        for (size_t i = chunk; i > 0; --i) {
+            if (buffer[i - 1] != '\0') {
+                return size - chunk + i;
+            }
+        }
+        size -= chunk;
+    }
+    return 0;
+}
+} // namespace
+
+MappedFileBackend::MappedFileBackend(const std::string& filepath, const size_t segment_size)
+    : segment_size_(std::max(PageSize(), segment_size / PageSize() * PageSize())) {
+    fd_ = OpenFile(filepath, length_);
+    if (fd_ == -1) {
+        throw std::runtime_error("Cannot open log file: " + filepath + ": "
+                                 + std::strerror(errno));
+    }
+    submitted_ = length_;
+
+    thread_ = std::thread(&MappedFileBackend::BackgroundLoop, this);
+}
+
+MappedFileBackend::~MappedFileBackend() {
+    Close();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    work_cv_.notify_one();
+    thread_.join();
+}
+
+void MappedFileBackend::Append(const std::string_view line) {
+    const size_t size = line.size() + 1;
+
+    if (map_ == nullptr || length_ + size > map_offset_ + map_size_) {
+        if (!MapSegment(size)) {
+            // Нет места или памяти: строка теряется, как и при ошибке write()
+            return;
+        }
+    }
+
+    char* out = map_ + (length_ - map_offset_);
+    std::memcpy(out, line.data(), line.size());
+    out[line.size()] = '\n';
+    length_ += size;
+
+    if (length_ >= submitted_ + kSubmitChunk) {
+        Submit();
+    }
+}
+
+void MappedFileBackend::Flush() {
+    // Строки уже в страничном кэше файла: их видят читатели, и они переживут
+    // аварийное завершение процесса. Запись на диск запускает фоновый поток
+}
+
+bool MappedFileBackend::Reopen(const std::string& filepath) {
+    uint64_t length = 0;
+    const int fd = OpenFile(filepath, length);
+    if (fd == -1) {
+        return false;
+    }
+
+    Close();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    fd_ = fd;
+    length_ = length;
+    submitted_ = length;
+    return true;
+}
+
+int MappedFileBackend::OpenFile(const std::string& filepath, uint64_t& length) {
+    const int fd = open(filepath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd == -1) {
+        return -1;
+    }
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0) {
+        const int error = errno;
+        close(fd);
+        errno = error;
+        return -1;
+    }
+
+    // Хвост предвыделенного сегмента после аварийного завершения
+    const auto size = static_cast<uint64_t>(info.st_size);
+    length = DataLength(fd, size);
+    if (length != size && ftruncate(fd, static_cast<off_t>(length)) != 0) {
+        const int error = errno;
+        close(fd);
+        errno = error;
+        return -1;
+    }
+    return fd;
+}
+
+bool MappedFileBackend::MapSegment(const size_t size) {
+    Unmap();
+
+    // Отображение начинается с границы страницы, на которой стоит позиция записи
+    const uint64_t offset = length_ / PageSize() * PageSize();
+    const size_t head = static_cast<size_t>(length_ - offset);
+    const size_t needed = (head + size + PageSize() - 1) / PageSize() * PageSize();
+    const size_t map_size = std::max(segment_size_, needed);
+
+    if (!Preallocate(fd_, offset, map_size)) {
+        return false;
+    }
+
+    void* map = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_,
+                     static_cast<off_t>(offset));
+    if (map == MAP_FAILED) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        map_ = static_cast<char*>(map);
+        map_size_ = map_size;
+        map_offset_ = offset;
+        prefault_begin_ = offset;
+        prefault_end_ = std::min<uint64_t>(offset + map_size, length_ + kPrefaultAhead);
+    }
+    work_cv_.notify_one();
+    return true;
+}
+
+void MappedFileBackend::Unmap() {
+    if (map_ == nullptr) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this] {
+        return !busy_;
+    });
+
+    // MAP_SHARED: данные уже в страничном кэше файла и не теряются
+    munmap(map_, map_size_);
+    map_ = nullptr;
+    map_size_ = 0;
+    prefault_begin_ = 0;
+    prefault_end_ = 0;
+}
+
+void MappedFileBackend::Submit() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (sync_end_ <= sync_begin_) {
+            sync_begin_ = submitted_;
+        }
+        sync_end_ = length_;
+        prefault_end_ = std::min<uint64_t>(map_offset_ + map_size_, length_ + kPrefaultAhead);
+    }
+    work_cv_.notify_one();
+    submitted_ = length_;
+}
+
+void MappedFileBackend::Close() {
+    Unmap();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this] {
+        return !busy_;
+    });
+    sync_begin_ = 0;
+    sync_end_ = 0;
+
+    if (fd_ != -1) {
+        ftruncate(fd_, static_cast<off_t>(length_));
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+void MappedFileBackend::BackgroundLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        work_cv_.wait(lock, [this] {
+            return sync_end_ > sync_begin_ || prefault_end_ > prefault_begin_ || stop_;
+        });
+        if (stop_) {
+            return;
+        }
+
+        // Дескриптор и сегмент не меняются, пока busy_ установлен
+        const int fd = fd_;
+        const uint64_t sync_begin = sync_begin_;
+        const uint64_t sync_end = sync_end_;
+        sync_begin_ = sync_end_;
+
+        char* prefault = nullptr;
+        size_t prefault_size = 0;
+        if (map_ != nullptr && prefault_end_ > prefault_begin_) {
+            prefault_size = static_cast<size_t>(
+                std::min(prefault_end_ - prefault_begin_, kPrefaultChunk));
+            prefault = map_ + (prefault_begin_ - map_offset_);
+            prefault_begin_ += prefault_size;
+        } else {
+            prefault_begin_ = prefault_end_;
+        }
+        busy_ = true;
+
+        lock.unlock();
+        if (fd != -1 && sync_end > sync_begin) {
+            SyncRange(fd, sync_begin, sync_end);
+        }
+        if (prefault != nullptr) {
+            Prefault(prefault, prefault_size);
+        }
+        lock.lock();
+
+        busy_ = false;
+        idle_cv_.notify_all();
+    }
+}
+
+} // namespace nexus::logger
@@ -0,0 +1,115 @@
+#pragma once
+
+/**
+ * @file mapped_file_backend.hpp
+ * @brief Запись файла лога копированием в предвыделенные сегменты, отображенные в память
+ */
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Base
+#include "file_backend.hpp"
+
+namespace nexus::logger {
+
+/**
+ * @class MappedFileBackend
+ * @brief Запись строк через mmap без системного вызова на каждый пакет
+ *
+ * Файл наращивается сегментами фиксированного размера (fallocate в Linux,
+ * ftruncate на других системах), текущий сегмент отображается в память,
+ * и строки дописываются в него обычным memcpy. Когда сегмент заполнен,
+ * отображается следующий.
+ *
+ * Строки попадают в страничный кэш файла сразу, поэтому Flush() ничего
+ * не копирует. Каждый записанный мегабайт передается фоновому потоку,
+ * который запускает его запись на диск (sync_file_range в Linux, fdatasync
+ * на других системах) и заранее отображает страницы впереди позиции записи
+ * (MADV_POPULATE_WRITE), чтобы поток записи не платил за их первое касание.
+ *
+ * При закрытии и ротации файл обрезается до реальной длины. После аварийного
+ * завершения процесса записанные строки остаются в страничном кэше и попадают
+ * в файл, а хвост из нулей предвыделенного сегмента отрезается при следующем
+ * открытии, так что запись продолжается с последней строки.
+ *
+ * @note До первой строки файл не расширяется: размер на диске равен длине данных.
+ *       Пока файл открыт, читатели видят в конце нули предвыделенного сегмента
+ */
+class MappedFileBackend final : public FileBackend {
+public:
+    /**
+     * @brief Конструктор
+     * @param filepath Путь к файлу лога (дописывается, хвост из нулей отрезается)
+     * @param segment_size Размер предвыделяемого и отображаемого сегмента в байтах
+     * @throw std::runtime_error При ошибках открытия файла
+     */
+    explicit MappedFileBackend(const std::string& filepath, size_t segment_size = 64 << 20);
+    ~MappedFileBackend() override;
+
+    void Append(std::string_view line) override;
+    void Flush() override;
+    bool Reopen(const std::string& filepath) override;
+
+private:
+    /**
+     * @brief Открытие файла с отрезанием нулевого хвоста
+     * @param filepath Путь к файлу
+     * @param length Длина данных в файле
+     * @return Дескриптор или -1 при ошибке
+     */
+    static int OpenFile(const std::string& filepath, uint64_t& length);
+
+    /// @brief Отображение сегмента с текущей позиции, вмещающего не меньше size байт
+    bool MapSegment(size_t size);
+
+    /// @brief Снятие отображения после завершения работы фонового потока с ним
+    void Unmap();
+
+    /// @brief Передача записанных данных и следующих страниц фоновому потоку
+    void Submit();
+
+    /// @brief Снятие отображения, ожидание фонового потока и обрезка файла до длины данных
+    void Close();
+
+    /// @brief Цикл фонового потока
+    void BackgroundLoop();
+
+    const size_t segment_size_;
+
+    /// @brief Дескриптор; меняется потоком записи под mutex_
+    int fd_{-1};
+
+    /// @brief Длина данных в файле (позиция следующей строки)
+    uint64_t length_{0};
+
+    /// @brief Граница данных, уже переданных фоновому потоку
+    uint64_t submitted_{0};
+
+    /// @brief Текущий сегмент; меняется потоком записи под mutex_
+    char* map_{nullptr};
+    size_t map_size_{0};
+    uint64_t map_offset_{0};
+
+    /// @brief Диапазон [sync_begin_, sync_end_), ждущий запуска записи
+    uint64_t sync_begin_{0};
+    uint64_t sync_end_{0};
+
+    /// @brief Диапазон [prefault_begin_, prefault_end_) текущего сегмента для предотображения
+    uint64_t prefault_begin_{0};
+    uint64_t prefault_end_{0};
+
+    /// @brief Фоновый поток работает с дескриптором и сегментом без блокировки
+    bool busy_{false};
+    bool stop_{false};
+
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable idle_cv_;
+    std::thread thread_;
+};
+
+} // namespace nexus::logger
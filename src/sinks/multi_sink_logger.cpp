@@ -0,0 +1,52 @@
+#include "multi_sink_logger.hpp"
+
+#include <utility>
+
+namespace nexus::logger {
+
+MultiSinkLogger::MultiSinkLogger(const std::string& server_name)
+    : BaseLogger(server_name) {
+    // Сбрасывают приемники по своим политикам, Flush() логгера не нужен
+    SetFlushPolicy(FlushPolicy{0, 0, std::chrono::milliseconds{0}, false});
+}
+
+MultiSinkLogger::~MultiSinkLogger() = default;
+
+void MultiSinkLogger::AddSink(std::string name, std::unique_ptr<LogSink> sink,
+                              const SinkOptions& options) {
+    workers_.push_back(std::make_unique<SinkWorker>(std::move(name), std::move(sink), options));
+}
+
+void MultiSinkLogger::Write(const std::string_view formatted_message) {
+    const SharedLine line = SharedLine::Create(ipc::LOG_INFO, formatted_message, true);
+    for (const auto& worker : workers_) {
+        worker->Push(line);
+    }
+}
+
+void MultiSinkLogger::Flush() {
+    // Служебные строки сбрасываются приемниками сразу, клиентские - по их политикам
+}
+
+void MultiSinkLogger::WriteMessage(const ipc::MessageCode level,
+                                   const std::string_view formatted_message) {
+    // Строка копируется один раз и только если она нужна хотя бы одному приемнику
+    SharedLine line;
+    for (const auto& worker : workers_) {
+        if (!worker->Accepts(level)) {
+            continue;
+        }
+        if (!line) {
+            line = SharedLine::Create(level, formatted_message, false);
+        }
+        worker->Push(line);
+    }
+}
+
+void MultiSinkLogger::OnWriterStopped() {
+    for (const auto& worker : workers_) {
+        worker->Drain();
+    }
+}
+
+} // namespace nexus::logger
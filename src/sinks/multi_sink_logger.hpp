@@ -0,0 +1,67 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+// Base
+#include "../core/logger/base_logger.hpp"
+
+// Sinks
+#include "log_sink.hpp"
+#include "sink_options.hpp"
+#include "sink_worker.hpp"
+
+namespace nexus::logger {
+/**
+ * @class MultiSinkLogger
+ * @brief Один логгер с несколькими приемниками (консоль, файлы)
+ *
+ * Поток записи логгера форматирует запись один раз и раздает ссылку на
+ * готовую строку очередям приемников, чей порог она проходит. Каждый
+ * приемник пишет в собственном потоке со своей политикой сброса, поэтому
+ * медленный приемник не тормозит остальные: при заполнении его очереди
+ * действует его политика переполнения (SinkOptions::overload_policy).
+ * Служебные строки логгера получают все приемники.
+ *
+ * Политика сброса логгера (SetFlushPolicy()) не действует: сброс задается
+ * для каждого приемника. Run() возвращается после того, как все приемники
+ * записали и сбросили принятые строки.
+ *
+ * @example
+ *     MultiSinkLogger logger(channels::LOGGER);
+ *     logger.AddSink("file", std::make_unique<FileSink>("/var/log/app.log"));
+ *     SinkOptions console;
+ *     console.min_severity = ipc::SEVERITY_WARN;
+ *     logger.AddSink("console", std::make_unique<ConsoleSink>(), console);
+ *     logger.Run();
+ */
+class MultiSinkLogger final : public BaseLogger {
+public:
+    /**
+     * @brief Конструктор
+     * @param server_name Имя логгера
+     */
+    explicit MultiSinkLogger(const std::string& server_name);
+    ~MultiSinkLogger() override;
+
+    /**
+     * @brief Добавление приемника
+     * @param name Имя приемника для служебных строк ("N messages dropped (sink name ...)")
+     * @param sink Приемник, логгер владеет им до уничтожения
+     * @param options Порог уровня, политика сброса и очередь приемника
+     *
+     * @note Должен вызываться до Run()
+     */
+    void AddSink(std::string name, std::unique_ptr<LogSink> sink,
+                 const SinkOptions& options = {});
+
+protected:
+    void Write(std::string_view formatted_message) override;
+    void Flush() override;
+    void WriteMessage(ipc::MessageCode level, std::string_view formatted_message) override;
+    void OnWriterStopped() override;
+
+private:
+    std::vector<std::unique_ptr<SinkWorker>> workers_;
+};
+} // namespace nexus::logger
@@ -0,0 +1,45 @@
+#pragma once
+
+/**
+ * @file rotation_policy.hpp
+ * @brief Политика ротации файла лога FileLogger
+ */
+
+#include <chrono>
+#include <cstddef>
+
+namespace nexus::logger {
+
+/**
+ * @brief Сжатие закрытых сегментов лога
+ */
+enum class SegmentCompression {
+    NONE, ///< Сегменты остаются как есть
+    GZIP  ///< Сегмент сжимается в <имя>.gz фоновым потоком (требует сборки с zlib)
+};
+
+/**
+ * @brief Условия ротации и хранения сегментов файла лога
+ *
+ * Ротация выполняется, как только выполнено любое из включенных условий.
+ * Нулевое значение порога отключает соответствующее условие.
+ * Значения по умолчанию отключают ротацию.
+ */
+struct RotationPolicy {
+    /// @brief Ротация перед записью, после которой файл превысит N байт
+    size_t max_size{0};
+
+    /// @brief Ротация на границах интервала местного времени (1 ч - в начале каждого часа)
+    std::chrono::seconds interval{0};
+
+    /// @brief Число хранимых закрытых сегментов, более старые удаляются
+    size_t max_files{0};
+
+    /// @brief Удаление сегментов, закрытых раньше заданного времени
+    std::chrono::seconds max_age{0};
+
+    /// @brief Сжатие закрытых сегментов
+    SegmentCompression compression{SegmentCompression::NONE};
+};
+
+} // namespace nexus::logger
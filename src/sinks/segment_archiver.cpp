@@ -0,0 +1,304 @@
+#include "segment_archiver.hpp"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
+#ifdef NEXUS_LOGGER_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <ctime>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Utils
+#include "common/utils/path_utils.hpp"
+
+namespace nexus::logger {
+
+namespace {
+// Период проверки возраста сегментов, когда ротаций нет
+constexpr std::chrono::seconds kRetentionCheckPeriod{60};
+
+// Размер блока чтения при сжатии
+constexpr size_t kCompressChunk = 64 * 1024;
+
+constexpr std::string_view kCompressedSuffix = ".gz";
+constexpr std::string_view kTemporarySuffix = ".tmp";
+
+bool EndsWith(const std::string& value, const std::string_view suffix) {
+    return value.size() >= suffix.size()
+           && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Сжатие не должно отнимать процессор у потоков приема и записи
+void LowerThreadPriority() {
+#if defined(__linux__)
+    // В Linux nice задается для отдельного потока
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+#else
+    int policy = 0;
+    sched_param param{};
+    if (pthread_getschedparam(pthread_self(), &policy, &param) == 0) {
+        param.sched_priority = sched_get_priority_min(policy);
+        pthread_setschedparam(pthread_self(), policy, &param);
+    }
+#endif
+}
+
+// Длина метки времени в имени сегмента: ГГГГММДД-ЧЧММСС
+constexpr size_t kStampLength = 15;
+
+struct SegmentEntry {
+    std::string stamp;
+    unsigned long index;
+    time_t modified;
+    std::string name;
+};
+} // namespace
+
+SegmentArchiver::SegmentArchiver(std::string filepath, const RotationPolicy& policy)
+    : filepath_(std::move(filepath)),
+      directory_(utils::path::GetDirectory(filepath_).empty()
+                     ? std::string(".")
+                     : utils::path::GetDirectory(filepath_)),
+      prefix_(filepath_.substr(filepath_.find_last_of('/') + 1) + "."),
+      policy_(policy) {
+    thread_ = std::thread(&SegmentArchiver::Loop, this);
+}
+
+SegmentArchiver::~SegmentArchiver() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_one();
+    thread_.join();
+}
+
+void SegmentArchiver::Submit(std::string segment) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.push_back(std::move(segment));
+    }
+    cv_.notify_one();
+}
+
+bool SegmentArchiver::CompressionAvailable() {
+#ifdef NEXUS_LOGGER_HAVE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+void SegmentArchiver::Loop() {
+    LowerThreadPriority();
+    CollectLeftovers();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        while (!pending_.empty() && !stop_) {
+            const std::string segment = std::move(pending_.front());
+            pending_.pop_front();
+
+            if (policy_.compression == SegmentCompression::GZIP) {
+                lock.unlock();
+                Compress(segment);
+                lock.lock();
+            }
+        }
+        if (stop_) {
+            return;
+        }
+
+        lock.unlock();
+        ApplyRetention();
+        lock.lock();
+
+        const auto ready = [this] {
+            return !pending_.empty() || stop_;
+        };
+        if (policy_.max_age.count() > 0) {
+            cv_.wait_for(lock, std::min(policy_.max_age, kRetentionCheckPeriod), ready);
+        } else {
+            cv_.wait(lock, ready);
+        }
+    }
+}
+
+bool SegmentArchiver::Compress(const std::string& segment) {
+#ifdef NEXUS_LOGGER_HAVE_ZLIB
+    const int input = open(segment.c_str(), O_RDONLY | O_CLOEXEC);
+    if (input == -1) {
+        // Сегмент уже удален ограничением хранения
+        return false;
+    }
+
+    struct stat info{};
+    const std::string target = segment + std::string(kCompressedSuffix);
+    const std::string temporary = target + std::string(kTemporarySuffix);
+    gzFile output = fstat(input, &info) == 0 ? gzopen(temporary.c_str(), "wb6") : nullptr;
+    if (output == nullptr) {
+        close(input);
+        return false;
+    }
+
+    std::vector<char> buffer(kCompressChunk);
+    bool ok = true;
+    for (;;) {
+        const ssize_t size = read(input, buffer.data(), buffer.size());
+        if (size == 0) {
+            break;
+        }
+        if (size == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ok = false;
+            break;
+        }
+        if (gzwrite(output, buffer.data(), static_cast<unsigned>(size)) != size) {
+            ok = false;
+            break;
+        }
+
+        // Остановка логгера не ждет сжатия: сегмент досжимается при следующем запуске
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_) {
+            ok = false;
+            break;
+        }
+    }
+    close(input);
+
+    if (gzclose(output) != Z_OK) {
+        ok = false;
+    }
+    if (!ok) {
+        unlink(temporary.c_str());
+        return false;
+    }
+
+    // Время изменения сохраняется: по нему считаются порядок и возраст сегментов
+    utimbuf times{};
+    times.actime = info.st_atime;
+    times.modtime = info.st_mtime;
+    utime(temporary.c_str(), &times);
+
+    if (rename(temporary.c_str(), target.c_str()) != 0) {
+        unlink(temporary.c_str());
+        return false;
+    }
+    unlink(segment.c_str());
+    return true;
+#else
+    (void)segment;
+    return false;
+#endif
+}
+
+void SegmentArchiver::ApplyRetention() const {
+    if (policy_.max_files == 0 && policy_.max_age.count() == 0) {
+        return;
+    }
+
+    DIR* dir = opendir(directory_.c_str());
+    if (dir == nullptr) {
+        return;
+    }
+
+    std::vector<SegmentEntry> segments;
+    while (const dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (!IsSegmentName(name)) {
+            continue;
+        }
+        struct stat info{};
+        if (stat((directory_ + "/" + name).c_str(), &info) != 0) {
+            continue;
+        }
+
+        // Порядок задает имя: время закрытия и номер ротации в пределах секунды
+        std::string stamp = name.substr(prefix_.size(), kStampLength);
+        const size_t index_at = prefix_.size() + kStampLength + 1;
+        const unsigned long index =
+            name.size() > index_at && name[index_at - 1] == '.'
+                    && std::isdigit(static_cast<unsigned char>(name[index_at])) != 0
+                ? std::strtoul(name.c_str() + index_at, nullptr, 10)
+                : 0;
+        segments.push_back({std::move(stamp), index, info.st_mtime, std::move(name)});
+    }
+    closedir(dir);
+
+    // Новые сегменты первыми
+    std::sort(segments.begin(), segments.end(),
+              [](const SegmentEntry& a, const SegmentEntry& b) {
+                  return a.stamp != b.stamp ? a.stamp > b.stamp : a.index > b.index;
+              });
+
+    const time_t now = std::time(nullptr);
+    for (size_t i = 0; i < segments.size(); ++i) {
+        const bool extra = policy_.max_files > 0 && i >= policy_.max_files;
+        const bool expired = policy_.max_age.count() > 0
+                             && now - segments[i].modified > policy_.max_age.count();
+        if (extra || expired) {
+            unlink((directory_ + "/" + segments[i].name).c_str());
+        }
+    }
+}
+
+void SegmentArchiver::CollectLeftovers() {
+    DIR* dir = opendir(directory_.c_str());
+    if (dir == nullptr) {
+        return;
+    }
+
+    std::vector<std::string> leftovers;
+    while (const dirent* entry = readdir(dir)) {
+        const std::string name = entry->d_name;
+        if (name.compare(0, prefix_.size(), prefix_) != 0) {
+            continue;
+        }
+        if (EndsWith(name, std::string(kCompressedSuffix) + std::string(kTemporarySuffix))) {
+            // Сжатие прервано остановкой или сбоем
+            unlink((directory_ + "/" + name).c_str());
+        } else if (IsSegmentName(name) && !EndsWith(name, kCompressedSuffix)) {
+            leftovers.push_back(directory_ + "/" + name);
+        }
+    }
+    closedir(dir);
+
+    if (policy_.compression != SegmentCompression::GZIP || leftovers.empty()) {
+        return;
+    }
+
+    std::sort(leftovers.begin(), leftovers.end());
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.insert(pending_.begin(), leftovers.begin(), leftovers.end());
+}
+
+bool SegmentArchiver::IsSegmentName(const std::string& name) const {
+    // <файл>.<ГГГГММДД-ЧЧММСС>..., временные файлы сжатия не считаются
+    return name.size() > prefix_.size()
+           && name.compare(0, prefix_.size(), prefix_) == 0
+           && std::isdigit(static_cast<unsigned char>(name[prefix_.size()])) != 0
+           && !EndsWith(name, kTemporarySuffix);
+}
+
+} // namespace nexus::logger
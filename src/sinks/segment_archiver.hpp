@@ -0,0 +1,88 @@
+#pragma once
+
+/**
+ * @file segment_archiver.hpp
+ * @brief Фоновое сжатие и удаление закрытых сегментов файла лога
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Sinks
+#include "rotation_policy.hpp"
+
+namespace nexus::logger {
+
+/**
+ * @class SegmentArchiver
+ * @brief Обслуживание закрытых сегментов в потоке с пониженным приоритетом
+ *
+ * Сегменты файла лога называются <файл>.<ГГГГММДД-ЧЧММСС>[.N][.gz]. Поток
+ * сжимает переданные ему сегменты и применяет к ним ограничения по числу
+ * и возрасту, поэтому поток записи логгера на ротации только переименовывает
+ * файл и открывает новый. Возраст сегмента отсчитывается от времени его
+ * последнего изменения.
+ *
+ * При запуске поток досжимает сегменты, оставшиеся несжатыми с прошлого
+ * запуска, и удаляет незавершенные временные файлы сжатия.
+ */
+class SegmentArchiver {
+public:
+    /**
+     * @brief Конструктор, запускает фоновый поток
+     * @param filepath Путь к активному файлу лога
+     * @param policy Ограничения хранения и сжатие
+     */
+    SegmentArchiver(std::string filepath, const RotationPolicy& policy);
+    ~SegmentArchiver();
+
+    SegmentArchiver(const SegmentArchiver&) = delete;
+    SegmentArchiver& operator=(const SegmentArchiver&) = delete;
+
+    /**
+     * @brief Передача закрытого сегмента на обслуживание
+     * @param segment Путь к переименованному сегменту
+     *
+     * @note Не блокируется на сжатии: только ставит путь в очередь
+     */
+    void Submit(std::string segment);
+
+    /**
+     * @brief Доступно ли сжатие в этой сборке
+     */
+    static bool CompressionAvailable();
+
+private:
+    /// @brief Цикл фонового потока
+    void Loop();
+
+    /// @brief Сжатие сегмента в <сегмент>.gz; false при ошибке или остановке
+    bool Compress(const std::string& segment);
+
+    /// @brief Удаление сегментов сверх max_files и старше max_age
+    void ApplyRetention() const;
+
+    /// @brief Поиск несжатых сегментов прошлого запуска
+    void CollectLeftovers();
+
+    /// @brief Является ли имя файла в директории лога сегментом
+    bool IsSegmentName(const std::string& name) const;
+
+    const std::string filepath_;
+    const std::string directory_;
+    const std::string prefix_;
+    const RotationPolicy policy_;
+
+    std::deque<std::string> pending_;
+    bool stop_{false};
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+};
+
+} // namespace nexus::logger
@@ -0,0 +1,101 @@
+#pragma once
+
+/**
+ * @file shared_line.hpp
+ * @brief Готовая строка лога, разделяемая несколькими приемниками
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string_view>
+#include <utility>
+
+// Types
+#include "../common/types/message_types.hpp"
+
+namespace nexus::logger {
+
+/**
+ * @class SharedLine
+ * @brief Строка лога со счетчиком ссылок
+ *
+ * Строка форматируется один раз и копируется в один блок памяти вместе
+ * со счетчиком; очереди приемников хранят только ссылки на блок. Блок
+ * освобождается последним приемником, записавшим строку.
+ *
+ * @note Копирование и уничтожение ссылок потокобезопасны, содержимое неизменно
+ */
+class SharedLine {
+public:
+    SharedLine() noexcept = default;
+
+    /**
+     * @brief Создание строки
+     * @param level Уровень сообщения
+     * @param text Текст строки без перевода строки
+     * @param raw Служебная строка логгера: пишется во все приемники и сбрасывается сразу
+     * @throw std::bad_alloc При нехватке памяти
+     */
+    static SharedLine Create(const ipc::MessageCode level, const std::string_view text,
+                             const bool raw) {
+        void* memory = ::operator new(sizeof(Block) + text.size());
+        auto* block = new (memory) Block{{1}, level, raw, text.size()};
+        std::memcpy(reinterpret_cast<char*>(block + 1), text.data(), text.size());
+        return SharedLine(block);
+    }
+
+    SharedLine(const SharedLine& other) noexcept : block_(other.block_) {
+        if (block_ != nullptr) {
+            block_->references.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    SharedLine(SharedLine&& other) noexcept : block_(std::exchange(other.block_, nullptr)) {
+    }
+
+    SharedLine& operator=(SharedLine other) noexcept {
+        std::swap(block_, other.block_);
+        return *this;
+    }
+
+    ~SharedLine() {
+        if (block_ != nullptr
+            && block_->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            block_->~Block();
+            ::operator delete(block_);
+        }
+    }
+
+    explicit operator bool() const noexcept {
+        return block_ != nullptr;
+    }
+
+    ipc::MessageCode Level() const noexcept {
+        return block_->level;
+    }
+
+    bool Raw() const noexcept {
+        return block_->raw;
+    }
+
+    std::string_view Text() const noexcept {
+        return {reinterpret_cast<const char*>(block_ + 1), block_->size};
+    }
+
+private:
+    struct Block {
+        std::atomic<uint32_t> references;
+        ipc::MessageCode level;
+        bool raw;
+        size_t size;
+    };
+
+    explicit SharedLine(Block* block) noexcept : block_(block) {
+    }
+
+    Block* block_{nullptr};
+};
+
+} // namespace nexus::logger
@@ -0,0 +1,45 @@
+#pragma once
+
+/**
+ * @file sink_options.hpp
+ * @brief Параметры отдельного приемника MultiSinkLogger
+ */
+
+#include <chrono>
+#include <cstddef>
+
+// Logger
+#include "../core/logger/flush_policy.hpp"
+#include "../core/logger/overload_policy.hpp"
+
+// Types
+#include "../common/types/message_types.hpp"
+
+namespace nexus::logger {
+
+/**
+ * @brief Порог, сброс и очередь одного приемника
+ *
+ * У каждого приемника своя очередь и свой поток записи, поэтому медленный
+ * приемник (консоль на последовательном порту) не задерживает быстрый (файл).
+ * По умолчанию заполненная очередь отбрасывает записи ниже ERROR, а не
+ * останавливает остальные приемники.
+ */
+struct SinkOptions {
+    /// @brief Записи ниже порога в приемник не попадают (служебные строки логгера - всегда)
+    ipc::Severity min_severity{ipc::SEVERITY_TRACE};
+
+    /// @brief Политика группового сброса приемника
+    FlushPolicy flush_policy{};
+
+    /// @brief Максимальное число строк в очереди приемника
+    size_t queue_capacity{4096};
+
+    /// @brief Поведение при заполненной очереди приемника
+    OverloadPolicy overload_policy{OverloadPolicy::DROP_BELOW_ERROR};
+
+    /// @brief Минимальный период между строками "N messages dropped" приемника
+    std::chrono::milliseconds drop_report_interval{1000};
+};
+
+} // namespace nexus::logger
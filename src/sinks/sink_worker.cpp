@@ -0,0 +1,203 @@
+#include "sink_worker.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace nexus::logger {
+
+SinkWorker::SinkWorker(std::string name, std::unique_ptr<LogSink> sink,
+                       const SinkOptions& options)
+    : name_(std::move(name)),
+      sink_(std::move(sink)),
+      options_(options),
+      capacity_(std::max<size_t>(options.queue_capacity, 1)) {
+    thread_ = std::thread(&SinkWorker::Loop, this);
+}
+
+SinkWorker::~SinkWorker() {
+    Stop();
+}
+
+void SinkWorker::Push(const SharedLine& line) {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (queue_.size() >= capacity_ && !MakeRoom(line, lock)) {
+            ++dropped_;
+            return;
+        }
+        if (closed_) {
+            return;
+        }
+        queue_.push_back(line);
+    }
+    not_empty_.notify_one();
+}
+
+void SinkWorker::Drain() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (closed_) {
+        return;
+    }
+
+    const uint64_t request = ++drain_requested_;
+    not_empty_.notify_one();
+    drained_.wait(lock, [this, request] {
+        return drain_completed_ >= request || closed_;
+    });
+}
+
+void SinkWorker::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    not_empty_.notify_one();
+    not_full_.notify_all();
+    drained_.notify_all();
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool SinkWorker::MakeRoom(const SharedLine& line, std::unique_lock<std::mutex>& lock) {
+    const OverloadPolicy policy = options_.overload_policy;
+    if (!line.Raw() && policy != OverloadPolicy::BLOCK) {
+        const bool below_error = policy == OverloadPolicy::DROP_BELOW_ERROR;
+        if (policy == OverloadPolicy::DROP_NEWEST
+            || (below_error && ipc::SeverityOf(line.Level()) < ipc::SEVERITY_ERROR)) {
+            return false;
+        }
+
+        // Вытесняется самая старая клиентская строка (для ERROR и FATAL - самая
+        // старая ниже ERROR), если вытеснять нечего - ждем места
+        const auto victim = std::find_if(queue_.begin(), queue_.end(),
+                                         [below_error](const SharedLine& queued) {
+            return !queued.Raw()
+                   && (!below_error || ipc::SeverityOf(queued.Level()) < ipc::SEVERITY_ERROR);
+        });
+        if (victim != queue_.end()) {
+            queue_.erase(victim);
+            ++dropped_;
+            return true;
+        }
+    }
+
+    not_full_.wait(lock, [this] {
+        return closed_ || queue_.size() < capacity_;
+    });
+    return true;
+}
+
+void SinkWorker::Loop() {
+    std::deque<SharedLine> batch;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        const auto ready = [this] {
+            return !queue_.empty() || closed_ || drain_requested_ != drain_completed_;
+        };
+        const auto deadline = NextDeadline();
+        if (deadline == std::chrono::steady_clock::time_point::max()) {
+            not_empty_.wait(lock, ready);
+        } else {
+            not_empty_.wait_until(lock, deadline, ready);
+        }
+
+        // Очередь забирается целиком: строки, поставленные до Drain(), попадают в эту пачку
+        batch.swap(queue_);
+        const uint64_t dropped = dropped_;
+        const uint64_t drain = drain_requested_;
+        const bool closed = closed_;
+        lock.unlock();
+        not_full_.notify_all();
+
+        for (const SharedLine& line : batch) {
+            WriteLine(line);
+        }
+        batch.clear();
+
+        const bool finish = closed || drain != drain_completed_;
+        ReportDropped(dropped, finish);
+
+        const auto now = std::chrono::steady_clock::now();
+        const bool delay_expired = options_.flush_policy.max_delay.count() > 0
+                                   && pending_messages_ > 0
+                                   && now - first_pending_time_ >= options_.flush_policy.max_delay;
+        // Не более одного сброса на пачку строк
+        if (flush_due_ || delay_expired || (finish && pending_messages_ > 0)) {
+            FlushPending();
+        }
+
+        lock.lock();
+        if (drain != drain_completed_) {
+            drain_completed_ = drain;
+            drained_.notify_all();
+        }
+        if (closed) {
+            return;
+        }
+    }
+}
+
+void SinkWorker::WriteLine(const SharedLine& line) {
+    const std::string_view text = line.Text();
+    sink_->Write(text);
+
+    // Служебная строка логгера сбрасывается сразу, как в одиночном логгере
+    if (line.Raw()) {
+        flush_due_ = true;
+        return;
+    }
+
+    if (pending_messages_ == 0) {
+        first_pending_time_ = std::chrono::steady_clock::now();
+    }
+    ++pending_messages_;
+    pending_bytes_ += text.size() + 1;
+
+    const FlushPolicy& policy = options_.flush_policy;
+    if ((policy.max_messages > 0 && pending_messages_ >= policy.max_messages)
+        || (policy.max_bytes > 0 && pending_bytes_ >= policy.max_bytes)
+        || (policy.flush_on_error && ipc::SeverityOf(line.Level()) >= ipc::SEVERITY_ERROR)) {
+        flush_due_ = true;
+    }
+}
+
+void SinkWorker::FlushPending() {
+    sink_->Flush();
+    pending_messages_ = 0;
+    pending_bytes_ = 0;
+    flush_due_ = false;
+}
+
+void SinkWorker::ReportDropped(const uint64_t dropped, const bool force) {
+    if (dropped == dropped_reported_) {
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (!force && now - last_drop_report_ < options_.drop_report_interval) {
+        return;
+    }
+
+    const std::string line = std::to_string(dropped - dropped_reported_)
+                             + " messages dropped (sink " + name_ + " queue full)";
+    sink_->Write(line);
+    flush_due_ = true;
+    dropped_reported_ = dropped;
+    last_drop_report_ = now;
+}
+
+std::chrono::steady_clock::time_point SinkWorker::NextDeadline() const {
+    auto deadline = std::chrono::steady_clock::time_point::max();
+    if (options_.flush_policy.max_delay.count() > 0 && pending_messages_ > 0) {
+        deadline = first_pending_time_ + options_.flush_policy.max_delay;
+    }
+    if (dropped_ != dropped_reported_) {
+        deadline = std::min(deadline, last_drop_report_ + options_.drop_report_interval);
+    }
+    return deadline;
+}
+
+} // namespace nexus::logger
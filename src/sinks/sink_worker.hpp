@@ -0,0 +1,127 @@
+#pragma once
+
+/**
+ * @file sink_worker.hpp
+ * @brief Очередь и поток записи одного приемника MultiSinkLogger
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Sinks
+#include "log_sink.hpp"
+#include "shared_line.hpp"
+#include "sink_options.hpp"
+
+namespace nexus::logger {
+
+/**
+ * @class SinkWorker
+ * @brief Доставка разделяемых строк в приемник собственным потоком
+ *
+ * Поток логгера только ставит ссылку на строку в ограниченную очередь,
+ * а поток приемника забирает очередь целиком, пишет строки и сбрасывает
+ * приемник по его политике сброса (не более одного Flush() на пачку строк,
+ * max_delay - по таймауту ожидания). Служебные строки сбрасываются сразу.
+ *
+ * Переполнение очереди обрабатывается так же, как в RecordQueue: клиентские
+ * строки отбрасываются или вытесняются по политике, служебные ждут места.
+ * Число отброшенных строк приемник получает строкой "N messages dropped".
+ */
+class SinkWorker {
+public:
+    /**
+     * @brief Конструктор, запускает поток приемника
+     * @param name Имя приемника для служебных строк
+     * @param sink Приемник
+     * @param options Порог, сброс и очередь приемника
+     */
+    SinkWorker(std::string name, std::unique_ptr<LogSink> sink, const SinkOptions& options);
+
+    /// @brief Дописывает очередь и останавливает поток
+    ~SinkWorker();
+
+    SinkWorker(const SinkWorker&) = delete;
+    SinkWorker& operator=(const SinkWorker&) = delete;
+
+    /// @brief Нужна ли приемнику клиентская строка уровня level
+    bool Accepts(ipc::MessageCode level) const noexcept {
+        return ipc::SeverityOf(level) >= options_.min_severity;
+    }
+
+    /**
+     * @brief Постановка строки в очередь приемника
+     * @param line Строка; клиентские строки должны проходить Accepts()
+     */
+    void Push(const SharedLine& line);
+
+    /**
+     * @brief Ожидание записи и сброса всех строк, поставленных до вызова
+     */
+    void Drain();
+
+    /**
+     * @brief Запись оставшихся строк, сброс приемника и остановка потока
+     * @note Повторный вызов ничего не делает
+     */
+    void Stop();
+
+private:
+    /// @brief Освобождение места по политике переполнения; false - строку отбросить
+    bool MakeRoom(const SharedLine& line, std::unique_lock<std::mutex>& lock);
+
+    /// @brief Цикл потока приемника
+    void Loop();
+
+    /// @brief Запись строки и учет порогов политики сброса
+    void WriteLine(const SharedLine& line);
+
+    /// @brief Сброс приемника и обнуление счетчиков политики
+    void FlushPending();
+
+    /**
+     * @brief Строка с числом отброшенных строк, не чаще drop_report_interval
+     * @param dropped Число строк, отброшенных с момента создания
+     * @param force Не учитывать период (остановка и Drain())
+     */
+    void ReportDropped(uint64_t dropped, bool force);
+
+    /// @brief Момент, когда потоку нужно проснуться без новых строк
+    std::chrono::steady_clock::time_point NextDeadline() const;
+
+    const std::string name_;
+    const std::unique_ptr<LogSink> sink_;
+    const SinkOptions options_;
+    const size_t capacity_;
+
+    /// @brief Очередь строк и ее состояние (под mutex_)
+    std::deque<SharedLine> queue_;
+    uint64_t dropped_{0};
+    bool closed_{false};
+
+    /// @brief Номера запросов Drain(): последний поступивший и последний выполненный
+    uint64_t drain_requested_{0};
+    uint64_t drain_completed_{0};
+
+    /// @brief Состояние политики сброса и отчетов (поток приемника)
+    size_t pending_messages_{0};
+    size_t pending_bytes_{0};
+    bool flush_due_{false};
+    std::chrono::steady_clock::time_point first_pending_time_{};
+    std::chrono::steady_clock::time_point last_drop_report_{};
+    uint64_t dropped_reported_{0};
+
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::condition_variable drained_;
+    std::thread thread_;
+};
+
+} // namespace nexus::logger
@@ -0,0 +1,40 @@
+#include "stream_file_backend.hpp"
+#include <stdexcept>
+#include <utility>
+
+namespace nexus::logger {
+StreamFileBackend::StreamFileBackend(const std::string& filepath) {
+    file_.open(filepath, std::ios::app);
+    if (!file_.is_open()) {
+        throw std::runtime_error("Cannot open log file: " + filepath);
+    }
+}
+
+StreamFileBackend::~StreamFileBackend() {
+    if (file_.is_open()) {
+        file_.close();
+    }
+}
+
+void StreamFileBackend::Append(const std::string_view line) {
+    if (file_.is_open()) {
+        file_.write(line.data(), static_cast<std::streamsize>(line.size()));
+        file_.put('\n');
+    }
+}
+
+void StreamFileBackend::Flush() {
+    if (file_.is_open()) {
+        file_.flush();
+    }
+}
+
+bool StreamFileBackend::Reopen(const std::string& filepath) {
+    std::ofstream file(filepath, std::ios::app);
+    if (!file.is_open()) {
+        return false;
+    }
+    file_ = std::move(file);
+    return true;
+}
+} // namespace nexus::logger
@@ -0,0 +1,21 @@
+#pragma once
+#include <fstream>
+#include <string>
+
+// Base
+#include "file_backend.hpp"
+
+namespace nexus::logger {
+class StreamFileBackend final : public FileBackend {
+public:
+    explicit StreamFileBackend(const std::string& filepath);
+    ~StreamFileBackend() override;
+
+    void Append(std::string_view line) override;
+    void Flush() override;
+    bool Reopen(const std::string& filepath) override;
+
+private:
+    std::ofstream file_;
+};
+} // namespace nexus::logger
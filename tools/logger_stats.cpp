@@ -0,0 +1,155 @@
+/**
+ * @file logger_stats.cpp
+ * @brief Утилита nexus_logger_stats: вывод метрик работающего логгера
+ *
+ * Отправляет логгеру STATS_QUERY и печатает снимок метрик. С --interval
+ * запрашивает снимки периодически и печатает скорости и квантили за интервал.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+// Logger
+#include "core/logger/logger_stats.hpp"
+
+// Utils & Types
+#include "common/types/channels_names.hpp"
+#include "common/types/stats_types.hpp"
+#include "common/utils/ipc_utils.hpp"
+
+namespace {
+
+using namespace nexus;
+
+constexpr std::string_view kUsage =
+    "Usage: nexus_logger_stats [options]\n"
+    "  --name NAME        logger channel name (logger)\n"
+    "  --interval MS      repeat every MS milliseconds, printing per-interval rates\n"
+    "  --count N          number of snapshots with --interval (0 - until interrupted)\n"
+    "  --histograms       print latency histogram buckets\n";
+
+struct StatsOptions {
+    std::string name{channels::LOGGER};
+    std::chrono::milliseconds interval{0};
+    size_t count{1};
+    bool histograms{false};
+};
+
+size_t ParseNumber(const std::string_view option, const std::string& value) {
+    try {
+        size_t end = 0;
+        const size_t parsed = std::stoul(value, &end);
+        if (end == value.size()) {
+            return parsed;
+        }
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument(std::string(option) + ": expected a number, got '" + value + "'");
+}
+
+StatsOptions ParseArguments(const int argc, char** argv) {
+    StatsOptions options;
+    bool count_set = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view option = argv[i];
+        if (option == "--help" || option == "-h") {
+            std::cout << kUsage;
+            std::exit(EXIT_SUCCESS);
+        }
+        if (option == "--histograms") {
+            options.histograms = true;
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            throw std::invalid_argument(std::string(option) + ": missing value");
+        }
+        const std::string value = argv[++i];
+
+        if (option == "--name") {
+            options.name = value;
+        } else if (option == "--interval") {
+            options.interval = std::chrono::milliseconds(ParseNumber(option, value));
+        } else if (option == "--count") {
+            options.count = ParseNumber(option, value);
+            count_set = true;
+        } else {
+            throw std::invalid_argument("unknown option " + std::string(option));
+        }
+    }
+
+    // С интервалом и без --count утилита работает до прерывания
+    if (options.interval.count() > 0 && !count_set) {
+        options.count = 0;
+    }
+    return options;
+}
+
+void PrintHistogram(const std::string_view title, const ipc::LatencyBuckets& buckets) {
+    std::cout << "  " << title << ":\n";
+    for (size_t i = 0; i < ipc::kLatencyBucketCount; ++i) {
+        if (buckets.counts[i] == 0) {
+            continue;
+        }
+        std::printf("    < %12llu ns  %llu\n",
+                    static_cast<unsigned long long>(ipc::LatencyBucketLimit(i)),
+                    static_cast<unsigned long long>(buckets.counts[i]));
+    }
+    std::fflush(stdout);
+}
+
+bool QueryStats(const int coid, ipc::LoggerStatsSnapshot& snapshot) {
+    const int status = utils::ipc::SendRequest(coid, ipc::STATS_QUERY, &snapshot,
+                                               sizeof(snapshot));
+    return status == static_cast<int>(sizeof(snapshot))
+           && snapshot.version == ipc::kStatsVersion;
+}
+
+} // namespace
+
+int main(const int argc, char** argv) {
+    try {
+        const StatsOptions options = ParseArguments(argc, argv);
+        const int coid = utils::ipc::ConnectToProcess(options.name);
+
+        ipc::LoggerStatsSnapshot previous{};
+        bool has_previous = false;
+        for (size_t n = 0; options.count == 0 || n < options.count; ++n) {
+            if (n > 0) {
+                std::this_thread::sleep_for(options.interval);
+            }
+
+            ipc::LoggerStatsSnapshot snapshot{};
+            if (!QueryStats(coid, snapshot)) {
+                std::cerr << "Error: logger '" << options.name
+                          << "' did not return a compatible stats snapshot\n";
+                utils::ipc::Disconnect(coid);
+                return EXIT_FAILURE;
+            }
+
+            std::cout << logger::LoggerStats::Format(snapshot, has_previous ? &previous : nullptr)
+                      << std::endl;
+            if (options.histograms) {
+                PrintHistogram("reply latency", snapshot.reply_latency);
+                PrintHistogram("write latency", snapshot.write_latency);
+                PrintHistogram("flush latency", snapshot.flush_latency);
+            }
+
+            previous = snapshot;
+            has_previous = true;
+        }
+
+        utils::ipc::Disconnect(coid);
+        return EXIT_SUCCESS;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}